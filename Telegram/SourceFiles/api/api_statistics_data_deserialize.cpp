@@ -19,7 +19,7 @@ Data::StatisticalGraph StatisticalGraphFromTL(const MTPStatsGraph &tl) {
 			? qs(*d.vzoom_token()).toUtf8()
 			: QByteArray();
 		return Data::StatisticalGraph{
-			StatisticalChartFromJSON(qs(d.vjson().data().vdata()).toUtf8()),
+			StatisticalChartFromJSON(d.vjson().data().vdata().v),
 			zoomToken,
 		};
 	}, [&](const MTPDstatsGraphAsync &data) {
@@ -22,6 +22,13 @@ namespace {
 constexpr auto kSendViewsTimeout = crl::time(1000);
 constexpr auto kPollExtendedMediaPeriod = 30 * crl::time(1000);
 constexpr auto kMaxPollPerRequest = 100;
+constexpr auto kPollSendDelay = 5;
+
+// Align poll times to whole seconds, so that polls for different peers
+// that became due at about the same time are sent in one batch.
+[[nodiscard]] crl::time AlignedPollTime(crl::time when) {
+	return ((when + 999) / 1000) * 1000;
+}
 
 } // namespace
 
@@ -73,12 +80,17 @@ void ViewsManager::pollExtendedMedia(
 	if (force) {
 		request.forced = true;
 	}
+	const auto now = crl::now();
 	const auto delay = force ? 1 : kPollExtendedMediaPeriod;
 	if (!request.id && (!request.when || force)) {
-		request.when = crl::now() + delay;
+		request.when = force
+			? (now + delay)
+			: AlignedPollTime(now + delay);
 	}
 	if (!_pollTimer.isActive() || force) {
-		_pollTimer.callOnce(delay);
+		_pollTimer.callOnce(request.id
+			? delay
+			: std::max(request.when - now, crl::time(1)));
 	}
 }
 
@@ -114,6 +126,7 @@ void ViewsManager::viewsIncrement() {
 void ViewsManager::sendPollRequests() {
 	const auto now = crl::now();
 	auto toRequest = base::flat_map<not_null<PeerData*>, QVector<MTPint>>();
+	auto messages = 0;
 	auto nearest = crl::time();
 	for (auto &[peer, request] : _pollRequests) {
 		if (request.id) {
@@ -134,6 +147,7 @@ void ViewsManager::sendPollRequests() {
 			for (const auto &id : request.sent) {
 				list.push_back(MTP_int(id.bare));
 			}
+			messages += int(list.size());
 			if (!request.ids.empty()) {
 				nearest = now;
 			}
@@ -141,6 +155,12 @@ void ViewsManager::sendPollRequests() {
 			nearest = request.when;
 		}
 	}
+	if (!toRequest.empty()) {
+		DEBUG_LOG(("Views Info: polling extended media "
+			"for %1 messages in %2 requests."
+			).arg(messages
+			).arg(toRequest.size()));
+	}
 	sendPollRequests(toRequest);
 	if (nearest) {
 		_pollTimer.callOnce(std::max(nearest - now, crl::time(1)));
@@ -171,9 +191,11 @@ void ViewsManager::sendPollRequests(
 						const auto delay = i->second.forced
 							? 1
 							: kPollExtendedMediaPeriod;
-						i->second.when = now + delay;
+						i->second.when = i->second.forced
+							? (now + delay)
+							: AlignedPollTime(now + delay);
 						if (!_pollTimer.isActive() || i->second.forced) {
-							_pollTimer.callOnce(delay);
+							_pollTimer.callOnce(i->second.when - now);
 						}
 						++i;
 					}
@@ -190,7 +212,7 @@ void ViewsManager::sendPollRequests(
 			finish(id);
 		}).fail([=](const MTP::Error &error, mtpRequestId id) {
 			finish(id);
-		}).send();
+		}).afterDelay(kPollSendDelay).send();
 
 		_pollRequests[peer].id = requestId;
 	}
@@ -2697,6 +2697,7 @@ std::vector<not_null<DocumentData*>> *ApiWrap::stickersByEmoji(
 }
 
 void ApiWrap::requestStickers(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().updateNeeded(now)
 		|| _stickersUpdateRequest) {
 		return;
@@ -2721,6 +2722,7 @@ void ApiWrap::requestStickers(TimeId now) {
 }
 
 void ApiWrap::requestMasks(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().masksUpdateNeeded(now)
 		|| _masksUpdateRequest) {
 		return;
@@ -2745,6 +2747,7 @@ void ApiWrap::requestMasks(TimeId now) {
 }
 
 void ApiWrap::requestCustomEmoji(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().emojiUpdateNeeded(now)
 		|| _customEmojiUpdateRequest) {
 		return;
@@ -2771,6 +2774,7 @@ void ApiWrap::requestCustomEmoji(TimeId now) {
 void ApiWrap::requestRecentStickers(
 		std::optional<TimeId> now,
 		bool attached) {
+	_session->readDeferredLocalData();
 	const auto needed = !now
 		? true
 		: attached
@@ -2829,6 +2833,7 @@ void ApiWrap::requestRecentStickers(
 }
 
 void ApiWrap::requestFavedStickers(std::optional<TimeId> now) {
+	_session->readDeferredLocalData();
 	if (now) {
 		if (!_session->data().stickers().favedUpdateNeeded(*now)
 			|| _favedStickersUpdateRequest) {
@@ -2863,6 +2868,7 @@ void ApiWrap::requestFavedStickers(std::optional<TimeId> now) {
 }
 
 void ApiWrap::requestFeaturedStickers(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().featuredUpdateNeeded(now)
 		|| _featuredStickersUpdateRequest) {
 		return;
@@ -2880,6 +2886,7 @@ void ApiWrap::requestFeaturedStickers(TimeId now) {
 }
 
 void ApiWrap::requestFeaturedEmoji(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().featuredEmojiUpdateNeeded(now)
 		|| _featuredEmojiUpdateRequest) {
 		return;
@@ -2898,6 +2905,7 @@ void ApiWrap::requestFeaturedEmoji(TimeId now) {
 }
 
 void ApiWrap::requestSavedGifs(TimeId now) {
+	_session->readDeferredLocalData();
 	if (!_session->data().stickers().savedGifsUpdateNeeded(now)
 		|| _savedGifsUpdateRequest) {
 		return;
@@ -119,6 +119,28 @@ size_type ValueToLimit(size_type timeLimit) {
 	return (timeLimit != kMaxTimeLimitValue) ? timeLimit : 0;
 }
 
+[[nodiscard]] rpl::producer<Storage::Cache::Database::Stats> SharedStats(
+		not_null<Storage::Cache::Database*> shared,
+		not_null<Storage::Cache::Database*> own) {
+	return (shared == own)
+		? rpl::single(Storage::Cache::Database::Stats())
+		: shared->statsOnMain();
+}
+
+[[nodiscard]] Storage::Cache::Database::Stats MergeStats(
+		Storage::Cache::Database::Stats &&stats,
+		const Storage::Cache::Database::Stats &shared) {
+	stats.full.count += shared.full.count;
+	stats.full.totalSize += shared.full.totalSize;
+	for (const auto &[tag, summary] : shared.tagged) {
+		auto &to = stats.tagged[tag];
+		to.count += summary.count;
+		to.totalSize += summary.totalSize;
+	}
+	stats.clearing = stats.clearing || shared.clearing;
+	return std::move(stats);
+}
+
 } // namespace
 
 class LocalStorageBox::Row : public Ui::RpWidget {
@@ -284,13 +306,20 @@ void LocalStorageBox::Show(not_null<::Main::Session*> session) {
 	auto shared = std::make_shared<object_ptr<LocalStorageBox>>(
 		Box<LocalStorageBox>(session, CreateTag()));
 	const auto weak = shared->data();
+	auto &data = session->data();
 	rpl::combine(
-		session->data().cache().statsOnMain(),
-		session->data().cacheBigFile().statsOnMain()
+		data.cache().statsOnMain(),
+		data.cacheBigFile().statsOnMain(),
+		SharedStats(&data.sharedCache(), &data.cache()),
+		SharedStats(&data.sharedCacheBigFile(), &data.cacheBigFile())
 	) | rpl::start_with_next([=](
 			Database::Stats &&stats,
-			Database::Stats &&statsBig) {
-		weak->update(std::move(stats), std::move(statsBig));
+			Database::Stats &&statsBig,
+			const Database::Stats &shared,
+			const Database::Stats &sharedBig) {
+		weak->update(
+			MergeStats(std::move(stats), shared),
+			MergeStats(std::move(statsBig), sharedBig));
 		if (auto &strong = *shared) {
 			Ui::show(std::move(strong));
 		}
@@ -348,13 +377,27 @@ auto LocalStorageBox::summary() const -> Database::TaggedSummary {
 }
 
 void LocalStorageBox::clearByTag(uint16 tag) {
+	const auto clearShared = [&] {
+		auto &shared = _session->data().sharedCache();
+		auto &sharedBig = _session->data().sharedCacheBigFile();
+		if (&shared != _db) {
+			shared.clear();
+		}
+		if (&sharedBig != _dbBig) {
+			sharedBig.clear();
+		}
+	};
 	if (tag == kFakeMediaCacheTag) {
 		_dbBig->clear();
 	} else if (tag) {
 		_db->clearByTag(tag);
+		if (tag == Data::kStickerCacheTag) {
+			clearShared();
+		}
 	} else {
 		_db->clear();
 		_dbBig->clear();
+		clearShared();
 		Ui::Emoji::ClearIrrelevantCache();
 	}
 }
@@ -594,5 +637,15 @@ void LocalStorageBox::save() {
 	updateBig.totalTimeLimit = _timeLimit;
 	_session->local().updateCacheSettings(update, updateBig);
 	_session->data().cache().updateSettings(update);
+
+	// Shared databases follow the limits of the last edited account.
+	auto &shared = _session->data().sharedCache();
+	auto &sharedBig = _session->data().sharedCacheBigFile();
+	if (&shared != _db) {
+		shared.updateSettings(update);
+	}
+	if (&sharedBig != _dbBig) {
+		sharedBig.updateSettings(updateBig);
+	}
 	closeBox();
 }
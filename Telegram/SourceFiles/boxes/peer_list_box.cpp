@@ -1105,6 +1105,8 @@ void PeerListContent::addToSearchIndex(not_null<PeerListRow*> row) {
 
 	removeFromSearchIndex(row);
 	row->setNameFirstLetters(row->generateNameFirstLetters());
+	_lastLocalSearchWords.clear();
+	_lastLocalResults.clear();
 	for (auto ch : row->nameFirstLetters()) {
 		_searchIndex[ch].push_back(row);
 	}
@@ -1124,6 +1126,8 @@ void PeerListContent::removeFromSearchIndex(not_null<PeerListRow*> row) {
 			}
 		}
 		row->setNameFirstLetters({});
+		_lastLocalSearchWords.clear();
+		_lastLocalResults.clear();
 	}
 }
 
@@ -1244,6 +1248,8 @@ void PeerListContent::clearAllContent() {
 	_rowsByPeer.clear();
 	_filterResults.clear();
 	_searchIndex.clear();
+	_lastLocalResults.clear();
+	_lastLocalSearchWords.clear();
 	_rows.clear();
 	_searchRows.clear();
 	_searchQuery
@@ -2037,46 +2043,7 @@ void PeerListContent::searchQueryChanged(QString query) {
 		if (_controller->searchInLocal() && !searchWordsList.isEmpty()) {
 			Assert(_hiddenRows.empty());
 
-			auto minimalList = (const std::vector<not_null<PeerListRow*>>*)nullptr;
-			for (const auto &searchWord : searchWordsList) {
-				auto searchWordStart = searchWord[0].toLower();
-				auto it = _searchIndex.find(searchWordStart);
-				if (it == _searchIndex.cend()) {
-					// Some word can't be found in any row.
-					minimalList = nullptr;
-					break;
-				} else if (!minimalList || minimalList->size() > it->second.size()) {
-					minimalList = &it->second;
-				}
-			}
-			if (minimalList) {
-				auto searchWordInNames = [](
-						not_null<PeerListRow*> row,
-						const QString &searchWord) {
-					for (auto &nameWord : row->generateNameWords()) {
-						if (nameWord.startsWith(searchWord)) {
-							return true;
-						}
-					}
-					return false;
-				};
-				auto allSearchWordsInNames = [&](
-						not_null<PeerListRow*> row) {
-					for (const auto &searchWord : searchWordsList) {
-						if (!searchWordInNames(row, searchWord)) {
-							return false;
-						}
-					}
-					return true;
-				};
-
-				_filterResults.reserve(minimalList->size());
-				for (const auto &row : *minimalList) {
-					if (allSearchWordsInNames(row)) {
-						_filterResults.push_back(row);
-					}
-				}
-			}
+			_filterResults = searchInLocal(searchWordsList);
 		}
 		if (_controller->hasComplexSearch()) {
 			_controller->search(_searchQuery);
@@ -2085,6 +2052,67 @@ void PeerListContent::searchQueryChanged(QString query) {
 	}
 }
 
+std::vector<not_null<PeerListRow*>> PeerListContent::searchInLocal(
+		const QStringList &searchWordsList) {
+	// While the query is being typed each new query usually refines the
+	// previous one: every previous word is a prefix of some new word.
+	// Then all new results are among the previous ones, so we filter
+	// those instead of the whole first letter bucket.
+	const auto refines = !_lastLocalSearchWords.isEmpty()
+		&& ranges::all_of(_lastLocalSearchWords, [&](const QString &was) {
+			return ranges::any_of(searchWordsList, [&](const QString &now) {
+				return now.startsWith(was);
+			});
+		});
+	auto candidates = (const std::vector<not_null<PeerListRow*>>*)nullptr;
+	if (refines) {
+		candidates = &_lastLocalResults;
+	} else {
+		for (const auto &searchWord : searchWordsList) {
+			const auto searchWordStart = searchWord[0].toLower();
+			const auto it = _searchIndex.find(searchWordStart);
+			if (it == _searchIndex.cend()) {
+				// Some word can't be found in any row.
+				candidates = nullptr;
+				break;
+			} else if (!candidates
+				|| candidates->size() > it->second.size()) {
+				candidates = &it->second;
+			}
+		}
+	}
+	const auto searchWordInNames = [](
+			not_null<PeerListRow*> row,
+			const QString &searchWord) {
+		// Name words are sorted, so all the words starting with
+		// searchWord follow right after lower_bound(searchWord).
+		const auto &nameWords = row->generateNameWords();
+		const auto i = nameWords.lower_bound(searchWord);
+		return (i != nameWords.end()) && i->startsWith(searchWord);
+	};
+	const auto allSearchWordsInNames = [&](not_null<PeerListRow*> row) {
+		for (const auto &searchWord : searchWordsList) {
+			if (!searchWordInNames(row, searchWord)) {
+				return false;
+			}
+		}
+		return true;
+	};
+
+	auto result = std::vector<not_null<PeerListRow*>>();
+	if (candidates) {
+		result.reserve(candidates->size());
+		for (const auto &row : *candidates) {
+			if (allSearchWordsInNames(row)) {
+				result.push_back(row);
+			}
+		}
+	}
+	_lastLocalResults = result;
+	_lastLocalSearchWords = searchWordsList;
+	return result;
+}
+
 std::unique_ptr<PeerListState> PeerListContent::saveState() const {
 	Expects(_hiddenRows.empty());
 
@@ -804,6 +804,8 @@ private:
 
 	void addRowEntry(not_null<PeerListRow*> row);
 	void addToSearchIndex(not_null<PeerListRow*> row);
+	[[nodiscard]] std::vector<not_null<PeerListRow*>> searchInLocal(
+		const QStringList &searchWordsList);
 	bool addingToSearchIndex() const;
 	void removeFromSearchIndex(not_null<PeerListRow*> row);
 	void setSearchQuery(const QString &query, const QString &normalizedQuery);
@@ -852,6 +854,8 @@ private:
 	std::map<PeerData*, std::vector<not_null<PeerListRow*>>> _rowsByPeer;
 
 	std::map<QChar, std::vector<not_null<PeerListRow*>>> _searchIndex;
+	std::vector<not_null<PeerListRow*>> _lastLocalResults;
+	QStringList _lastLocalSearchWords;
 	QString _searchQuery;
 	QString _normalizedSearchQuery;
 	QString _mentionHighlight;
@@ -21,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_changes.h"
 #include "data/data_session.h"
 #include "main/main_session.h"
+#include "main/session/session_timer_wheel.h"
 #include "window/window_session_controller.h"
 #include "info/profile/info_profile_values.h"
 #include "ui/text/format_values.h"
@@ -226,16 +227,20 @@ void ProcessFullPhoto(
 
 [[nodiscard]] rpl::producer<QString> StatusValue(not_null<PeerData*> peer) {
 	if (const auto user = peer->asUser()) {
-		const auto now = base::unixtime::now();
 		return [=](auto consumer) {
 			auto lifetime = rpl::lifetime();
-			const auto timer = lifetime.make_state<base::Timer>();
-			const auto push = [=] {
+			const auto refresh = lifetime.make_state<rpl::lifetime>();
+			const auto push = lifetime.make_state<Fn<void()>>();
+			*push = [=] {
+				const auto now = base::unixtime::now();
 				consumer.put_next(Data::OnlineText(user, now));
-				timer->callOnce(Data::OnlineChangeTimeout(user, now));
+				*refresh = user->session().timerWheel().after(
+					Data::OnlineChangeTimeout(user, now)
+				) | rpl::start_with_next([=] {
+					(*push)();
+				});
 			};
-			timer->setCallback(push);
-			push();
+			(*push)();
 			return lifetime;
 		};
 	}
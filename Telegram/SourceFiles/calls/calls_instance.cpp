@@ -13,6 +13,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "calls/group/calls_group_call.h"
 #include "calls/group/calls_group_rtmp.h"
 #include "mtproto/mtproto_dh_utils.h"
+#include "mtproto/details/mtproto_dump_to_text.h"
 #include "core/application.h"
 #include "core/core_settings.h"
 #include "main/main_session.h"
@@ -606,7 +607,8 @@ void Instance::handleCallUpdate(
 	} else if (!_currentCall
 		|| (&_currentCall->user()->session() != session)
 		|| !_currentCall->handleUpdate(call)) {
-		DEBUG_LOG(("API Warning: unexpected phone call update %1").arg(call.type()));
+		DEBUG_LOG(("API Warning: unexpected phone call update %1"
+			).arg(MTP::details::TypeName(call.type())));
 	}
 }
 
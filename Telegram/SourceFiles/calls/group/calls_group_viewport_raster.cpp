@@ -24,6 +24,10 @@ namespace {
 
 constexpr auto kBlurRadius = 15;
 
+// Blurred backgrounds are drawn upscaled with smooth transform anyway,
+// so we blur a smaller image with a proportionally smaller radius.
+constexpr auto kBlurDownscale = 2;
+
 } // namespace
 
 Viewport::RendererSW::RendererSW(not_null<Viewport*> owner)
@@ -79,9 +83,9 @@ void Viewport::RendererSW::validateUserpicFrame(
 	data.userpicFrame = Images::BlurLargeImage(
 		tile->row()->peer()->generateUserpicImage(
 			tile->row()->ensureUserpicView(),
-			size.width(),
+			std::max(size.width() / kBlurDownscale, 1),
 			0),
-		kBlurRadius);
+		kBlurRadius / kBlurDownscale);
 }
 
 void Viewport::RendererSW::paintTile(
@@ -104,16 +108,23 @@ void Viewport::RendererSW::paintTile(
 	} else if (tileData.blurredFrame.isNull()) {
 		tileData.blurredFrame = Images::BlurLargeImage(
 			data.original.scaled(
-				VideoTile::PausedVideoSize(),
+				VideoTile::PausedVideoSize() / kBlurDownscale,
 				Qt::KeepAspectRatio).mirrored(tile->mirror(), false),
-			kBlurRadius);
+			kBlurRadius / kBlurDownscale);
 	}
-	const auto &image = _userpicFrame
+	const auto frameRotation = _userpicFrame ? 0 : data.rotation;
+	const auto live = !_userpicFrame && !_pausedFrame;
+
+	// Mirror not rotated live frames while painting instead of making
+	// a full-size copy of each frame.
+	const auto mirrorInPainter = live && tile->mirror() && !frameRotation;
+	const auto image = _userpicFrame
 		? tileData.userpicFrame
 		: _pausedFrame
 		? tileData.blurredFrame
+		: mirrorInPainter
+		? data.original
 		: data.original.mirrored(tile->mirror(), false);
-	const auto frameRotation = _userpicFrame ? 0 : data.rotation;
 	Assert(!image.isNull());
 
 	const auto background = _owner->_fullscreen
@@ -140,7 +151,13 @@ void Viewport::RendererSW::paintTile(
 	const auto left = (width - scaled.width()) / 2;
 	const auto top = (height - scaled.height()) / 2;
 	const auto target = QRect(QPoint(x + left, y + top), scaled);
-	if (UsePainterRotation(frameRotation)) {
+	if (mirrorInPainter) {
+		p.save();
+		p.translate(2 * target.x() + target.width(), 0);
+		p.scale(-1., 1.);
+		p.drawImage(target, image);
+		p.restore();
+	} else if (UsePainterRotation(frameRotation)) {
 		if (frameRotation) {
 			p.save();
 			p.rotate(frameRotation);
@@ -22,6 +22,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include <QtGui/QGuiApplication>
 
+#include <unordered_set>
+
 namespace ChatHelpers {
 namespace {
 
@@ -32,6 +34,7 @@ constexpr auto kKeepNotUsedInputLanguagesCount = 4;
 using namespace Ui::Emoji;
 
 using Result = EmojiKeywords::Result;
+using FoundEmoji = std::unordered_set<EmojiPtr>;
 
 struct LangPackEmoji {
 	EmojiPtr emoji = nullptr;
@@ -175,30 +178,19 @@ void WriteLocalCache(const QString &id, const LangPackData &data) {
 
 void AppendFoundEmoji(
 		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &label,
 		const std::vector<LangPackEmoji> &list) {
-	// It is important that the 'result' won't relocate while inserting.
-	result.reserve(result.size() + list.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		list
-	) | ranges::views::filter([&](const LangPackEmoji &entry) {
-		const auto i = ranges::find(
-			alreadyBegin,
-			alreadyEnd,
-			entry.emoji,
-			&Result::emoji);
-		return (i == alreadyEnd);
-	}) | ranges::views::transform([&](const LangPackEmoji &entry) {
-		return Result{ entry.emoji, label, entry.text };
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &entry : list) {
+		if (found.emplace(entry.emoji).second) {
+			result.push_back({ entry.emoji, label, entry.text });
+		}
+	}
 }
 
 void AppendLegacySuggestions(
 		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &query) {
 	const auto badSuggestionChar = [](QChar ch) {
 		return (ch < 'a' || ch > 'z')
@@ -213,32 +205,17 @@ void AppendLegacySuggestions(
 	}
 
 	const auto suggestions = GetSuggestions(QStringToUTF16(query));
-
-	// It is important that the 'result' won't relocate while inserting.
 	result.reserve(result.size() + suggestions.size());
-	const auto alreadyBegin = begin(result);
-	const auto alreadyEnd = alreadyBegin + result.size();
-
-	auto &&add = ranges::views::all(
-		suggestions
-	) | ranges::views::transform([](const Suggestion &suggestion) {
-		return Result{
-			Find(QStringFromUTF16(suggestion.emoji())),
-			QStringFromUTF16(suggestion.label()),
-			QStringFromUTF16(suggestion.replacement())
-		};
-	}) | ranges::views::filter([&](const Result &entry) {
-		const auto i = entry.emoji
-			? ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji)
-			: alreadyEnd;
-		return (entry.emoji != nullptr)
-			&& (i == alreadyEnd);
-	});
-	result.insert(end(result), add.begin(), add.end());
+	for (const auto &suggestion : suggestions) {
+		const auto emoji = Find(QStringFromUTF16(suggestion.emoji()));
+		if (emoji && found.emplace(emoji).second) {
+			result.push_back({
+				emoji,
+				QStringFromUTF16(suggestion.label()),
+				QStringFromUTF16(suggestion.replacement())
+			});
+		}
+	}
 }
 
 void ApplyDifference(
@@ -319,7 +296,9 @@ public:
 	void refresh();
 	void apiChanged();
 
-	[[nodiscard]] std::vector<Result> query(
+	void query(
+		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &normalized,
 		bool exact) const;
 	[[nodiscard]] int maxQueryLength() const;
@@ -470,29 +449,29 @@ void EmojiKeywords::LangPack::apiChanged() {
 	refresh();
 }
 
-std::vector<Result> EmojiKeywords::LangPack::query(
+void EmojiKeywords::LangPack::query(
+		std::vector<Result> &result,
+		FoundEmoji &found,
 		const QString &normalized,
 		bool exact) const {
 	if (normalized.size() > _data.maxKeyLength
 		|| _data.emoji.empty()
 		|| (exact && SkipExactKeyword(_id, normalized))) {
-		return {};
+		return;
+	} else if (exact) {
+		const auto i = _data.emoji.find(normalized);
+		if (i != end(_data.emoji)) {
+			AppendFoundEmoji(result, found, i->first, i->second);
+		}
+		return;
 	}
-
-	const auto from = _data.emoji.lower_bound(normalized);
-	auto &&chosen = ranges::make_subrange(
-		from,
-		end(_data.emoji)
-	) | ranges::views::take_while([&](const auto &pair) {
-		const auto &key = pair.first;
-		return exact ? (key == normalized) : key.startsWith(normalized);
-	});
-
-	auto result = std::vector<Result>();
-	for (const auto &[key, list] : chosen) {
-		AppendFoundEmoji(result, key, list);
+	const auto till = end(_data.emoji);
+	for (auto i = _data.emoji.lower_bound(normalized); i != till; ++i) {
+		if (!i->first.startsWith(normalized)) {
+			break;
+		}
+		AppendFoundEmoji(result, found, i->first, i->second);
 	}
-	return result;
 }
 
 int EmojiKeywords::LangPack::maxQueryLength() const {
@@ -612,31 +591,15 @@ std::vector<Result> EmojiKeywords::query(
 	if (normalized.isEmpty()) {
 		return {};
 	}
+	// Results from all the language packs are deduplicated by emoji,
+	// the first pack (and the first keyword) that found it wins.
 	auto result = std::vector<Result>();
+	auto found = FoundEmoji();
 	for (const auto &[language, item] : _data) {
-		const auto list = item->query(normalized, exact);
-
-		// It is important that the 'result' won't relocate while inserting.
-		result.reserve(result.size() + list.size());
-		const auto alreadyBegin = begin(result);
-		const auto alreadyEnd = alreadyBegin + result.size();
-
-		auto &&add = ranges::views::all(
-			list
-		) | ranges::views::filter([&](Result entry) {
-			// In each item->query() result the list has no duplicates.
-			// So we need to check only for duplicates between queries.
-			const auto i = ranges::find(
-				alreadyBegin,
-				alreadyEnd,
-				entry.emoji,
-				&Result::emoji);
-			return (i == alreadyEnd);
-		});
-		result.insert(end(result), add.begin(), add.end());
+		item->query(result, found, normalized, exact);
 	}
 	if (!exact) {
-		AppendLegacySuggestions(result, query);
+		AppendLegacySuggestions(result, found, query);
 	}
 	return result;
 }
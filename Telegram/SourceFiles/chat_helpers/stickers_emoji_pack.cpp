@@ -280,14 +280,14 @@ std::unique_ptr<Lottie::SinglePlayer> EmojiPack::effectPlayer(
 		baseKey.low + keyShift
 	};
 	const auto get = [=](int i, FnMut<void(QByteArray &&cached)> handler) {
-		document->owner().cacheBigFile().get(
+		document->owner().sharedCacheBigFile().get(
 			{ key.high, key.low + i },
 			std::move(handler));
 	};
 	const auto weak = base::make_weak(&document->session());
 	const auto put = [=](int i, QByteArray &&cached) {
 		crl::on_main(weak, [=, data = std::move(cached)]() mutable {
-			weak->data().cacheBigFile().put(
+			weak->data().sharedCacheBigFile().put(
 				{ key.high, key.low + i },
 				std::move(data));
 		});
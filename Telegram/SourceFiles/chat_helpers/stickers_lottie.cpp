@@ -50,14 +50,14 @@ auto LottieCachedFromContent(
 		baseKey.low + keyShift
 	};
 	const auto get = [=](FnMut<void(QByteArray &&cached)> handler) {
-		session->data().cacheBigFile().get(
+		session->data().sharedCacheBigFile().get(
 			key,
 			std::move(handler));
 	};
 	const auto weak = base::make_weak(session);
 	const auto put = [=](QByteArray &&cached) {
 		crl::on_main(weak, [=, data = std::move(cached)]() mutable {
-			weak->data().cacheBigFile().put(key, std::move(data));
+			weak->data().sharedCacheBigFile().put(key, std::move(data));
 		});
 	};
 	return method(
@@ -11,6 +11,7 @@ sys.dont_write_bytecode = True
 scriptPath = os.path.dirname(os.path.realpath(__file__))
 sys.path.append(scriptPath + '/../../../lib_tl/tl')
 from generate_tl import generate
+from scheme_dispatch import generate_dispatch
 
 generate({
   'namespaces': {
@@ -97,3 +98,5 @@ generate({
   },
 
 })
+
+generate_dispatch(sys.argv)
@@ -0,0 +1,187 @@
+'''
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+'''
+import re, os
+
+# Generates scheme-dispatch.h next to scheme.h with a constexpr perfect
+# hash table of all the constructor ids, their names and the minimal
+# serialized length, for fast type id lookups without a switch. The
+# session drops received objects that are shorter than that length.
+
+fixedLengths = {
+  '#': 1,
+  'int': 1,
+  'long': 2,
+  'double': 2,
+  'int128': 4,
+  'int256': 8,
+  'string': 1,
+  'bytes': 1,
+}
+
+def parseArguments(argv):
+  output = ''
+  inputs = []
+  for arg in argv[1:]:
+    if arg.startswith('-o'):
+      output = arg[2:]
+    else:
+      inputs.append(arg)
+  return output, inputs
+
+def minimalLength(fieldType):
+  if '?' in fieldType:
+    return 0 # Conditional field, may be skipped.
+  if fieldType in fixedLengths:
+    return fixedLengths[fieldType]
+  if fieldType.startswith('Vector<'):
+    return 2 # Vector type id and the count.
+  if fieldType.startswith('vector<'):
+    return 1 # Bare vector, only the count.
+  if fieldType[0].isupper():
+    return 1 # Boxed type, at least the type id.
+  return 0 # Bare type or a template parameter, don't guess.
+
+def readConstructors(inputs):
+  result = []
+  known = set()
+  for path in inputs:
+    functions = False
+    with open(path, 'r', encoding='utf-8') as f:
+      for line in f:
+        line = line.strip()
+        if line.startswith('//') or not line:
+          continue
+        if line == '---functions---':
+          functions = True
+          continue
+        if line == '---types---':
+          functions = False
+          continue
+        if functions:
+          continue
+        match = re.match(r'^([a-zA-Z0-9_.]+)#([0-9a-f]+)\s+(.*)=\s*[^=]+;$', line)
+        if not match:
+          continue
+        name = match.group(1)
+        typeId = int(match.group(2), 16)
+        if typeId in known:
+          continue
+        known.add(typeId)
+        length = 0
+        for field in match.group(3).split():
+          if field.startswith('{') or ':' not in field:
+            continue
+          length += minimalLength(field.split(':', 1)[1])
+        result.append((typeId, name, length))
+  return result
+
+def mix(value, seed):
+  x = (value ^ seed) & 0xFFFFFFFF
+  x ^= x >> 16
+  x = (x * 0x7FEB352D) & 0xFFFFFFFF
+  x ^= x >> 15
+  x = (x * 0x846CA68B) & 0xFFFFFFFF
+  x ^= x >> 16
+  return x
+
+# Hash and displace: each bucket of the first level hash gets a seed
+# that places all its ids in free slots of the second level.
+def buildPerfectHash(ids):
+  slotsCount = len(ids)
+  bucketsCount = max(1, slotsCount // 4)
+  buckets = [[] for _ in range(bucketsCount)]
+  for index, typeId in enumerate(ids):
+    buckets[mix(typeId, 0) % bucketsCount].append(index)
+  seeds = [0] * bucketsCount
+  slots = [-1] * slotsCount
+  order = sorted(range(bucketsCount), key=lambda b: -len(buckets[b]))
+  for bucket in order:
+    members = buckets[bucket]
+    if not members:
+      continue
+    seed = 1
+    while True:
+      taken = [mix(ids[index], seed) % slotsCount for index in members]
+      if len(set(taken)) == len(taken) and all(slots[s] < 0 for s in taken):
+        break
+      seed += 1
+    seeds[bucket] = seed
+    for index, slot in zip(members, taken):
+      slots[slot] = index
+  return seeds, slots
+
+def generate_dispatch(argv):
+  output, inputs = parseArguments(argv)
+  if not output or not inputs:
+    return
+  constructors = readConstructors(inputs)
+  seeds, slots = buildPerfectHash([entry[0] for entry in constructors])
+
+  lines = []
+  lines.append('// WARNING! All changes made in this file will be lost!')
+  lines.append('// Created from ' + ', '.join(os.path.basename(p) for p in inputs) + ' by codegen_scheme.py')
+  lines.append('//')
+  lines.append('#pragma once')
+  lines.append('')
+  lines.append('#include <array>')
+  lines.append('#include <cstdint>')
+  lines.append('')
+  lines.append('namespace MTP::details::dispatch {')
+  lines.append('')
+  lines.append('struct Constructor {')
+  lines.append('\tuint32_t id = 0;')
+  lines.append('\tconst char *name = nullptr;')
+  lines.append('')
+  lines.append('\t// Serialized length lower bound in primes, without the type id.')
+  lines.append('\tuint32_t minimalLength = 0;')
+  lines.append('};')
+  lines.append('')
+  lines.append('inline constexpr auto kConstructorsCount = ' + str(len(constructors)) + ';')
+  lines.append('')
+  lines.append('inline constexpr auto kConstructors = std::array<Constructor, kConstructorsCount>{{')
+  for typeId, name, length in constructors:
+    lines.append('\t{ 0x%08xU, "%s", %d },' % (typeId, name, length))
+  lines.append('}};')
+  lines.append('')
+  lines.append('inline constexpr auto kSeeds = std::array<uint32_t, ' + str(len(seeds)) + '>{{')
+  for i in range(0, len(seeds), 16):
+    lines.append('\t' + ', '.join(str(s) for s in seeds[i:i + 16]) + ',')
+  lines.append('}};')
+  lines.append('')
+  lines.append('inline constexpr auto kSlots = std::array<uint16_t, kConstructorsCount>{{')
+  for i in range(0, len(slots), 16):
+    lines.append('\t' + ', '.join(str(s) for s in slots[i:i + 16]) + ',')
+  lines.append('}};')
+  lines.append('')
+  lines.append('[[nodiscard]] constexpr uint32_t Mix(uint32_t value, uint32_t seed) {')
+  lines.append('\tauto x = value ^ seed;')
+  lines.append('\tx ^= x >> 16;')
+  lines.append('\tx *= 0x7FEB352DU;')
+  lines.append('\tx ^= x >> 15;')
+  lines.append('\tx *= 0x846CA68BU;')
+  lines.append('\tx ^= x >> 16;')
+  lines.append('\treturn x;')
+  lines.append('}')
+  lines.append('')
+  lines.append('[[nodiscard]] constexpr const Constructor *Find(uint32_t id) {')
+  lines.append('\tconst auto seed = kSeeds[Mix(id, 0) % kSeeds.size()];')
+  lines.append('\tconst auto &result = kConstructors[kSlots[Mix(id, seed) % kSlots.size()]];')
+  lines.append('\treturn (seed && result.id == id) ? &result : nullptr;')
+  lines.append('}')
+  lines.append('')
+  lines.append('} // namespace MTP::details::dispatch')
+  lines.append('')
+
+  content = '\n'.join(lines)
+  path = output + '-dispatch.h'
+  if os.path.isfile(path):
+    with open(path, 'r', encoding='utf-8') as f:
+      if f.read() == content:
+        return
+  with open(path, 'w', encoding='utf-8') as f:
+    f.write(content)
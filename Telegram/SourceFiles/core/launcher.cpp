@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/crash_reports.h"
 #include "core/update_checker.h"
 #include "core/sandbox.h"
+#include "core/startup_trace.h"
 #include "base/concurrent_timer.h"
 #include "base/options.h"
 
@@ -520,6 +521,7 @@ void Launcher::processArguments() {
 		{ "-workdir"        , KeyFormat::OneValue },
 		{ "--"              , KeyFormat::OneValue },
 		{ "-scale"          , KeyFormat::OneValue },
+		{ "-tracestartup"   , KeyFormat::NoValues },
 	};
 	auto parseResult = QMap<QByteArray, QStringList>();
 	auto parsingKey = QByteArray();
@@ -546,6 +548,9 @@ void Launcher::processArguments() {
 
 	static const auto RegExp = QRegularExpression("[^a-z0-9\\-_]");
 	gDebugMode = parseResult.contains("-debug");
+	if (parseResult.contains("-tracestartup")) {
+		StartupTrace::Start();
+	}
 	gKeyFile = parseResult
 		.value("-key", {})
 		.join(QString())
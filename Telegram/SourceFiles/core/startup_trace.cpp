@@ -0,0 +1,137 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "core/startup_trace.h"
+
+#include <QtCore/QMutex>
+#include <QtCore/QThread>
+
+#include <chrono>
+
+namespace Core::StartupTrace {
+namespace {
+
+struct Event {
+	const char *name = nullptr;
+	int64 started = 0;
+	int64 duration = -1; // Instant event if negative.
+	uint64 thread = 0;
+};
+
+struct State {
+	std::chrono::steady_clock::time_point origin;
+	QMutex mutex;
+	std::vector<Event> events;
+	std::atomic<bool> finished = false;
+};
+
+std::unique_ptr<State> Tracing;
+
+[[nodiscard]] int64 Now() {
+	using namespace std::chrono;
+	return duration_cast<microseconds>(
+		steady_clock::now() - Tracing->origin).count();
+}
+
+[[nodiscard]] uint64 CurrentThread() {
+	return uint64(reinterpret_cast<quintptr>(QThread::currentThreadId()));
+}
+
+void Push(Event &&event) {
+	QMutexLocker lock(&Tracing->mutex);
+	Tracing->events.push_back(std::move(event));
+}
+
+[[nodiscard]] QByteArray Serialize(const std::vector<Event> &events) {
+	auto result = QByteArray("{\"traceEvents\":[");
+	auto threads = base::flat_map<uint64, int>();
+	auto first = true;
+	for (const auto &event : events) {
+		const auto i = threads.emplace(
+			event.thread,
+			int(threads.size()) + 1).first;
+		if (!first) {
+			result.append(',');
+		}
+		first = false;
+		result.append("\n{\"name\":\"").append(event.name);
+		result.append("\",\"cat\":\"startup\",\"pid\":1,\"tid\":");
+		result.append(QByteArray::number(i->second));
+		result.append(",\"ts\":").append(QByteArray::number(event.started));
+		if (event.duration >= 0) {
+			result.append(",\"ph\":\"X\",\"dur\":");
+			result.append(QByteArray::number(event.duration));
+		} else {
+			result.append(",\"ph\":\"i\",\"s\":\"g\"");
+		}
+		result.append('}');
+	}
+	result.append("\n],\"displayTimeUnit\":\"ms\"}\n");
+	return result;
+}
+
+} // namespace
+
+void Start() {
+	if (Tracing) {
+		return;
+	}
+	Tracing = std::make_unique<State>();
+	Tracing->origin = std::chrono::steady_clock::now();
+	Mark("Start");
+}
+
+bool Enabled() {
+	return Tracing && !Tracing->finished;
+}
+
+void Mark(const char *name) {
+	if (Enabled()) {
+		Push({ .name = name, .started = Now(), .thread = CurrentThread() });
+	}
+}
+
+void Finish() {
+	if (!Enabled()) {
+		return;
+	}
+	Mark("Finish");
+	Tracing->finished = true;
+
+	auto events = std::vector<Event>();
+	{
+		QMutexLocker lock(&Tracing->mutex);
+		events = base::take(Tracing->events);
+	}
+	const auto path = cWorkingDir() + u"tdata/startup_trace.json"_q;
+	auto file = QFile(path);
+	if (file.open(QIODevice::WriteOnly)) {
+		file.write(Serialize(events));
+		LOG(("Startup trace written to '%1'.").arg(path));
+	} else {
+		LOG(("Startup trace could not be written to '%1'.").arg(path));
+	}
+}
+
+Span::Span(const char *name) : _name(name) {
+	if (Enabled()) {
+		_started = Now();
+	}
+}
+
+Span::~Span() {
+	if (_started >= 0 && Enabled()) {
+		Push({
+			.name = _name,
+			.started = _started,
+			.duration = Now() - _started,
+			.thread = CurrentThread(),
+		});
+	}
+}
+
+} // namespace Core::StartupTrace
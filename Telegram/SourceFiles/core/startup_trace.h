@@ -0,0 +1,33 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+namespace Core::StartupTrace {
+
+// Collects startup phases when launched with -tracestartup and writes them
+// to tdata/startup_trace.json (Chrome trace event format) when the chats
+// list is painted for the first time.
+void Start();
+[[nodiscard]] bool Enabled();
+void Mark(const char *name);
+void Finish();
+
+class Span final {
+public:
+	explicit Span(const char *name);
+	Span(const Span &other) = delete;
+	Span &operator=(const Span &other) = delete;
+	~Span();
+
+private:
+	const char *_name = nullptr;
+	int64 _started = -1;
+
+};
+
+} // namespace Core::StartupTrace
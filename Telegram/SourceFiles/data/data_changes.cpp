@@ -23,12 +23,78 @@ void Changes::Manager<DataType, UpdateType>::updated(
 			flags |= i->second;
 			_updates.erase(i);
 		}
-		_stream.fire({ data, flags });
+		fire({ data, flags });
 	} else {
 		_updates[data] |= flags;
 	}
 }
 
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::fire(UpdateType &&update) {
+	_stream.fire_copy(update);
+
+	const auto &[data, flags] = update;
+	const auto i = _buckets->find(data);
+	if (i != _buckets->end() && (i->second->mask & flags)) {
+		const auto bucket = i->second.get();
+		++bucket->firing;
+		bucket->stream.fire(std::move(update));
+		if (!--bucket->firing && !bucket->subscribers) {
+			_buckets->remove(data);
+		}
+	}
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::Subscribe(
+		not_null<Buckets*> buckets,
+		not_null<DataType*> data,
+		Flags flags) {
+	auto &bucket = (*buckets)[data];
+	if (!bucket) {
+		bucket = std::make_unique<Bucket>();
+	}
+	++bucket->subscribers;
+	for (auto i = 0; i != kCount; ++i) {
+		if (flags & static_cast<Flag>(1ULL << i)) {
+			++bucket->flagSubscribers[i];
+		}
+	}
+	bucket->mask |= flags;
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::Unsubscribe(
+		not_null<Buckets*> buckets,
+		not_null<DataType*> data,
+		Flags flags) {
+	const auto i = buckets->find(data);
+	if (i == buckets->end()) {
+		return;
+	}
+	const auto bucket = i->second.get();
+	for (auto bit = 0; bit != kCount; ++bit) {
+		if (flags & static_cast<Flag>(1ULL << bit)) {
+			--bucket->flagSubscribers[bit];
+		}
+	}
+	RefreshMask(bucket);
+	if (!--bucket->subscribers && !bucket->firing) {
+		buckets->erase(i);
+	}
+}
+
+template <typename DataType, typename UpdateType>
+void Changes::Manager<DataType, UpdateType>::RefreshMask(
+		not_null<Bucket*> bucket) {
+	bucket->mask = 0;
+	for (auto i = 0; i != kCount; ++i) {
+		if (bucket->flagSubscribers[i] > 0) {
+			bucket->mask |= static_cast<Flag>(1ULL << i);
+		}
+	}
+}
+
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendRealtimeNotifications(
 		not_null<DataType*> data,
@@ -54,10 +120,26 @@ template <typename DataType, typename UpdateType>
 rpl::producer<UpdateType> Changes::Manager<DataType, UpdateType>::updates(
 		not_null<DataType*> data,
 		Flags flags) const {
-	return _stream.events(
-	) | rpl::filter([=](const UpdateType &update) {
-		const auto &[updateData, updateFlags] = update;
-		return (updateData == data) && (updateFlags & flags);
+	const auto weak = std::weak_ptr<Buckets>(_buckets);
+	return rpl::make_producer<UpdateType>([=](auto consumer) {
+		const auto buckets = weak.lock();
+		if (!buckets) {
+			return rpl::lifetime();
+		}
+		Subscribe(buckets.get(), data, flags);
+		auto subscription = ((*buckets)[data]->stream.events(
+		) | rpl::filter([=](const UpdateType &update) {
+			return (update.flags & flags);
+		})).start_existing(consumer);
+
+		// Detach the consumer before the bucket with its stream may go.
+		return rpl::lifetime([=, subscription = std::move(subscription)](
+		) mutable {
+			subscription.destroy();
+			if (const auto strong = weak.lock()) {
+				Unsubscribe(strong.get(), data, flags);
+			}
+		});
 	});
 }
 
@@ -84,7 +166,7 @@ void Changes::Manager<DataType, UpdateType>::drop(not_null<DataType*> data) {
 template <typename DataType, typename UpdateType>
 void Changes::Manager<DataType, UpdateType>::sendNotifications() {
 	for (const auto &[data, flags] : base::take(_updates)) {
-		_stream.fire({ data, flags });
+		fire({ data, flags });
 	}
 }
 
@@ -371,13 +371,39 @@ private:
 	private:
 		static constexpr auto kCount = details::CountBit<Flag>() + 1;
 
+		// Subscribers of updates(data, flags) are routed by the data
+		// pointer, so firing an update doesn't run every other filter.
+		struct Bucket {
+			rpl::event_stream<UpdateType> stream;
+			std::array<int, kCount> flagSubscribers = {};
+			Flags mask = 0;
+			int subscribers = 0;
+			int firing = 0;
+		};
+		using Buckets = base::flat_map<
+			not_null<DataType*>,
+			std::unique_ptr<Bucket>>;
+
 		void sendRealtimeNotifications(
 			not_null<DataType*> data,
 			Flags flags);
+		void fire(UpdateType &&update);
+
+		static void Subscribe(
+			not_null<Buckets*> buckets,
+			not_null<DataType*> data,
+			Flags flags);
+		static void Unsubscribe(
+			not_null<Buckets*> buckets,
+			not_null<DataType*> data,
+			Flags flags);
+		static void RefreshMask(not_null<Bucket*> bucket);
 
 		std::array<rpl::event_stream<UpdateType>, kCount> _realtimeStreams;
 		base::flat_map<not_null<DataType*>, Flags> _updates;
 		rpl::event_stream<UpdateType> _stream;
+		const std::shared_ptr<Buckets> _buckets
+			= std::make_shared<Buckets>();
 
 	};
 
@@ -526,7 +526,7 @@ void DocumentData::setDataAndCache(const QByteArray &data) {
 		media->setBytes(data);
 	}
 	if (saveToCache() && data.size() <= Storage::kMaxFileInMemory) {
-		owner().cache().put(
+		owner().cacheForTag(cacheTag()).put(
 			cacheKey(),
 			Storage::Cache::Database::TaggedValue(
 				base::duplicate(data),
@@ -1738,7 +1738,9 @@ void DocumentData::collectLocalData(not_null<DocumentData*> local) {
 		return;
 	}
 
-	_owner->cache().copyIfEmpty(local->cacheKey(), cacheKey());
+	_owner->cacheForTag(cacheTag()).copyIfEmpty(
+		local->cacheKey(),
+		cacheKey());
 	if (const auto localMedia = local->activeMediaView()) {
 		auto media = createMediaView();
 		media->collectLocalData(localMedia.get());
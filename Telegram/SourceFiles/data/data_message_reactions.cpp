@@ -43,6 +43,7 @@ namespace {
 
 constexpr auto kRefreshFullListEach = 60 * 60 * crl::time(1000);
 constexpr auto kPollEach = 20 * crl::time(1000);
+constexpr auto kPollSendDelay = 5;
 constexpr auto kSizeForDownscale = 64;
 constexpr auto kRecentRequestTimeout = 10 * crl::time(1000);
 constexpr auto kRecentReactionsLimit = 40;
@@ -1466,7 +1467,7 @@ void Reactions::poll(not_null<HistoryItem*> item, crl::time now) {
 			}
 		}
 	} else if (!_pollingItems.contains(item)) {
-		if (_pollItems.empty() && !_pollRequestId) {
+		if (_pollItems.empty() && !_pollRequests) {
 			crl::on_main(&_owner->session(), [=] {
 				pollCollected();
 			});
@@ -1622,24 +1623,35 @@ void Reactions::pollCollected() {
 	for (const auto &item : _pollingItems) {
 		toRequest[item->history()->peer].push_back(MTP_int(item->id));
 	}
+	DEBUG_LOG(("Reactions Info: polling %1 messages in %2 requests."
+		).arg(_pollingItems.size()
+		).arg(toRequest.size()));
+
+	// All the requests of one poll are finalized together, so that
+	// the next poll gathers items from every peer again.
+	const auto finalize = [=] {
+		if (--_pollRequests > 0) {
+			return;
+		}
+		const auto now = crl::now();
+		for (const auto &item : base::take(_pollingItems)) {
+			const auto last = item->lastReactionsRefreshTime();
+			if (last && last + kPollEach <= now) {
+				item->updateReactions(nullptr);
+			}
+		}
+		if (!_pollItems.empty()) {
+			crl::on_main(&_owner->session(), [=] {
+				pollCollected();
+			});
+		}
+	};
 	auto &api = _owner->session().api();
+	_pollRequests = int(toRequest.size());
 	for (const auto &[peer, ids] : toRequest) {
-		const auto finalize = [=] {
-			const auto now = crl::now();
-			for (const auto &item : base::take(_pollingItems)) {
-				const auto last = item->lastReactionsRefreshTime();
-				if (last && last + kPollEach <= now) {
-					item->updateReactions(nullptr);
-				}
-			}
-			_pollRequestId = 0;
-			if (!_pollItems.empty()) {
-				crl::on_main(&_owner->session(), [=] {
-					pollCollected();
-				});
-			}
-		};
-		_pollRequestId = api.request(MTPmessages_GetMessagesReactions(
+		// Delay a little, so that views and extended media polls
+		// for the same screen are sent in the same container.
+		api.request(MTPmessages_GetMessagesReactions(
 			peer->input,
 			MTP_vector<MTPint>(ids)
 		)).done([=](const MTPUpdates &result) {
@@ -1647,7 +1659,7 @@ void Reactions::pollCollected() {
 			finalize();
 		}).fail([=] {
 			finalize();
-		}).send();
+		}).afterDelay(kPollSendDelay).send();
 	}
 }
 
@@ -347,7 +347,7 @@ private:
 	base::Timer _repaintTimer;
 	base::flat_set<not_null<HistoryItem*>> _pollItems;
 	base::flat_set<not_null<HistoryItem*>> _pollingItems;
-	mtpRequestId _pollRequestId = 0;
+	int _pollRequests = 0;
 
 	base::flat_map<not_null<HistoryItem*>, crl::time> _sendPaidItems;
 	base::flat_map<not_null<HistoryItem*>, mtpRequestId> _sendingPaid;
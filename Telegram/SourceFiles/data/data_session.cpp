@@ -8,8 +8,11 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_session.h"
 
 #include "main/main_session.h"
+#include "main/main_domain.h"
+#include "storage/storage_cache_policy.h"
 #include "main/main_session_settings.h"
 #include "main/main_app_config.h"
+#include "main/session/session_timer_wheel.h"
 #include "apiwrap.h"
 #include "mainwidget.h"
 #include "api/api_bot.h"
@@ -230,7 +233,6 @@ Session::Session(not_null<Main::Session*> session)
 , _ttlCheckTimer([=] { checkTTLs(); })
 , _selfDestructTimer([=] { checkSelfDestructItems(); })
 , _pollsClosingTimer([=] { checkPollsClosings(); })
-, _watchForOfflineTimer([=] { checkLocalUsersWentOffline(); })
 , _groups(this)
 , _chatsFilters(std::make_unique<ChatFilters>(this))
 , _cloudThemes(std::make_unique<CloudThemes>(session))
@@ -252,6 +254,10 @@ Session::Session(not_null<Main::Session*> session)
 	_cache->open(_session->local().cacheKey());
 	_bigFileCache->open(_session->local().cacheBigFileKey());
 
+	_session->domain().openSharedCaches(
+		_session->local().cacheSettings(),
+		_session->local().cacheBigFileSettings());
+
 	if constexpr (Platform::IsLinux()) {
 		const auto wasVersion = _session->local().oldMapVersion();
 		if (wasVersion >= 1007011 && wasVersion < 1007015) {
@@ -260,6 +266,7 @@ Session::Session(not_null<Main::Session*> session)
 		}
 	}
 
+	setupCacheAccessTrace();
 	setupMigrationViewer();
 	setupChannelLeavingViewer();
 	setupPeerNameViewer();
@@ -1124,14 +1131,20 @@ void Session::watchForOffline(not_null<UserData*> user, TimeId now) {
 		}
 		i->second = till;
 	}
-	const auto timeout = Data::OnlineChangeTimeout(lastseen, now);
-	const auto fires = _watchForOfflineTimer.isActive()
-		? _watchForOfflineTimer.remainingTime()
-		: -1;
-	if (fires >= 0 && fires <= timeout) {
+	watchForOfflineIn(Data::OnlineChangeTimeout(lastseen, now));
+}
+
+void Session::watchForOfflineIn(crl::time timeout) {
+	const auto at = crl::now() + timeout;
+	if (_watchForOfflineAt && _watchForOfflineAt <= at) {
 		return;
 	}
-	_watchForOfflineTimer.callOnce(std::max(timeout, crl::time(1)));
+	_watchForOfflineAt = at;
+	_watchForOfflineLifetime = _session->timerWheel().after(
+		timeout
+	) | rpl::start_with_next([=] {
+		checkLocalUsersWentOffline();
+	});
 }
 
 void Session::maybeStopWatchForOffline(not_null<UserData*> user) {
@@ -1139,12 +1152,13 @@ void Session::maybeStopWatchForOffline(not_null<UserData*> user) {
 		return;
 	} else if (_watchingForOffline.remove(user)
 		&& _watchingForOffline.empty()) {
-		_watchForOfflineTimer.cancel();
+		_watchForOfflineAt = 0;
+		_watchForOfflineLifetime.destroy();
 	}
 }
 
 void Session::checkLocalUsersWentOffline() {
-	_watchForOfflineTimer.cancel();
+	_watchForOfflineAt = 0;
 
 	auto minimal = 86400 * crl::time(1000);
 	const auto now = base::unixtime::now();
@@ -1163,7 +1177,7 @@ void Session::checkLocalUsersWentOffline() {
 		}
 	}
 	if (!_watchingForOffline.empty()) {
-		_watchForOfflineTimer.callOnce(std::max(minimal, crl::time(1)));
+		watchForOfflineIn(minimal);
 	}
 }
 
@@ -1347,6 +1361,97 @@ Storage::Cache::Database &Session::cacheBigFile() {
 	return *_bigFileCache;
 }
 
+Storage::Cache::Database &Session::sharedCache() {
+	const auto result = _session->domain().sharedCache();
+	return result ? *result : cache();
+}
+
+Storage::Cache::Database &Session::sharedCacheBigFile() {
+	const auto result = _session->domain().sharedCacheBigFile();
+	return result ? *result : cacheBigFile();
+}
+
+Storage::Cache::Database &Session::cacheForTag(uint8 tag) {
+	return (tag == kStickerCacheTag) ? sharedCache() : cache();
+}
+
+void Session::cacheGetForTag(
+		const Storage::Cache::Key &key,
+		uint8 tag,
+		FnMut<void(QByteArray&&)> done) {
+	auto &cache = cacheForTag(tag);
+	if (&cache == _cache.get()) {
+		cache.get(key, std::move(done));
+		return;
+	}
+
+	// Stickers cached before the shared database was added are still
+	// in the account database, they're moved to the shared one on read.
+	const auto weak = base::make_weak(_session);
+	const auto moved = [=](QByteArray value) {
+		crl::on_main(weak, [=] {
+			auto &data = weak->data();
+			data.cacheForTag(tag).putIfEmpty(
+				key,
+				Storage::Cache::Database::TaggedValue(
+					base::duplicate(value),
+					tag));
+			data.cache().remove(key);
+		});
+	};
+	cache.get(key, [=, done = std::move(done)](
+			QByteArray &&value) mutable {
+		if (!value.isEmpty()) {
+			done(std::move(value));
+			return;
+		}
+		crl::on_main(weak, [=, done = std::move(done)]() mutable {
+			weak->data().cache().get(key, [=, done = std::move(done)](
+					QByteArray &&value) mutable {
+				if (!value.isEmpty()) {
+					moved(value);
+				}
+				done(std::move(value));
+			});
+		});
+	});
+}
+
+auto Session::cacheAccessTrace() const
+-> std::shared_ptr<Storage::CacheAccessTrace> {
+	return _cacheAccessTrace;
+}
+
+void Session::setupCacheAccessTrace() {
+	if (!Storage::CacheAccessTraceEnabled()) {
+		return;
+	}
+	const auto path = _session->local().cachePath() + u"_trace"_q;
+	const auto capacity = _session->local().cacheSettings().totalSizeLimit;
+	// Misses of stickers and of inline shown media are noticed the most.
+	const auto weights = Storage::CacheTagWeights{
+		{ kImageCacheTag, { .cost = 2. } },
+		{ kStickerCacheTag, { .cost = 4., .frequent = true } },
+		{ kVoiceMessageCacheTag, { .cost = 2. } },
+		{ kVideoMessageCacheTag, { .cost = 2. } },
+	};
+	_cacheAccessTrace = std::make_shared<Storage::CacheAccessTrace>(path);
+	crl::async([=, recorder = _cacheAccessTrace] {
+		const auto trace = recorder->take();
+		if (trace.empty()) {
+			return;
+		}
+		const auto results = Storage::SimulateCachePolicies(
+			trace,
+			capacity,
+			weights);
+		LOG(("Cache Info: Replayed %1 accesses, capacity %2.\n%3"
+			).arg(trace.size()
+			).arg(capacity
+			).arg(Storage::CacheSimulationReport(results)));
+	});
+}
+
 void Session::suggestStartExport(TimeId availableAt) {
 	_exportAvailableAt = availableAt;
 	suggestStartExport();
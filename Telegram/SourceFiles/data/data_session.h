@@ -35,6 +35,10 @@ namespace Ui {
 class BoxContent;
 } // namespace Ui
 
+namespace Storage {
+class CacheAccessTrace;
+} // namespace Storage
+
 namespace Passport {
 struct SavedCredentials;
 } // namespace Passport
@@ -176,6 +180,17 @@ public:
 	[[nodiscard]] Storage::Cache::Database &cache();
 	[[nodiscard]] Storage::Cache::Database &cacheBigFile();
 
+	// Shared by all the accounts, for public content only.
+	[[nodiscard]] Storage::Cache::Database &sharedCache();
+	[[nodiscard]] Storage::Cache::Database &sharedCacheBigFile();
+	[[nodiscard]] Storage::Cache::Database &cacheForTag(uint8 tag);
+	void cacheGetForTag(
+		const Storage::Cache::Key &key,
+		uint8 tag,
+		FnMut<void(QByteArray&&)> done);
+	[[nodiscard]] auto cacheAccessTrace() const
+		-> std::shared_ptr<Storage::CacheAccessTrace>;
+
 	[[nodiscard]] not_null<PeerData*> peer(PeerId id);
 	[[nodiscard]] not_null<PeerData*> peer(UserId id) = delete;
 	[[nodiscard]] not_null<UserData*> user(UserId id);
@@ -780,6 +795,7 @@ private:
 
 	void suggestStartExport();
 
+	void setupCacheAccessTrace();
 	void setupMigrationViewer();
 	void setupChannelLeavingViewer();
 	void setupPeerNameViewer();
@@ -787,6 +803,7 @@ private:
 
 	void checkSelfDestructItems();
 	void checkLocalUsersWentOffline();
+	void watchForOfflineIn(crl::time timeout);
 
 	void scheduleNextTTLs();
 	void checkTTLs();
@@ -909,6 +926,7 @@ private:
 
 	Storage::DatabasePointer _cache;
 	Storage::DatabasePointer _bigFileCache;
+	std::shared_ptr<Storage::CacheAccessTrace> _cacheAccessTrace;
 
 	TimeId _exportAvailableAt = 0;
 	QPointer<Ui::BoxContent> _exportSuggestion;
@@ -1069,7 +1087,8 @@ private:
 	uint64 _wallpapersHash = 0;
 
 	base::flat_map<not_null<UserData*>, TimeId> _watchingForOffline;
-	base::Timer _watchForOfflineTimer;
+	crl::time _watchForOfflineAt = 0;
+	rpl::lifetime _watchForOfflineLifetime;
 
 	base::flat_map<not_null<PeerData*>, MTP::DcId> _peerStatsDcIds;
 
@@ -84,6 +84,10 @@ public:
 	void clearIncomingNotifications();
 	[[nodiscard]] auto currentNotification() const
 		-> std::optional<ItemNotification>;
+	[[nodiscard]] auto pendingNotifications() const
+		-> const std::deque<ItemNotification> & {
+		return _notifications;
+	}
 	bool hasNotification() const;
 	void skipNotification();
 	void pushNotification(ItemNotification notification);
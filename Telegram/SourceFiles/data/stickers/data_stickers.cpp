@@ -147,6 +147,28 @@ Main::Session &Stickers::session() const {
 	return _owner->session();
 }
 
+// Those are read from the local storage with a delay, so they are read
+// right away if they're going to be changed before that.
+StickersSetsOrder &Stickers::maskSetsOrderRef() {
+	session().readDeferredLocalData();
+	return _maskSetsOrder;
+}
+
+StickersSetsOrder &Stickers::featuredSetsOrderRef() {
+	session().readDeferredLocalData();
+	return _featuredSetsOrder;
+}
+
+StickersSetsOrder &Stickers::featuredEmojiSetsOrderRef() {
+	session().readDeferredLocalData();
+	return _featuredEmojiSetsOrder;
+}
+
+SavedGifs &Stickers::savedGifsRef() {
+	session().readDeferredLocalData();
+	return _savedGifs;
+}
+
 void Stickers::notifyUpdated(StickersType type) {
 	_updated.fire_copy(type);
 }
@@ -314,6 +336,7 @@ void Stickers::incrementSticker(not_null<DocumentData*> document) {
 void Stickers::addSavedGif(
 		std::shared_ptr<ChatHelpers::Show> show,
 		not_null<DocumentData*> document) {
+	session().readDeferredLocalData();
 	const auto index = _savedGifs.indexOf(document);
 	if (!index) {
 		return;
@@ -576,6 +599,7 @@ void Stickers::setIsFaved(
 		std::shared_ptr<ChatHelpers::Show> show,
 		not_null<DocumentData*> document,
 		std::optional<std::vector<not_null<EmojiPtr>>> emojiList) {
+	session().readDeferredLocalData();
 	auto &sets = setsRef();
 	auto it = sets.find(FavedSetId);
 	if (it == sets.end()) {
@@ -658,6 +682,7 @@ void Stickers::removeFromRecentSet(not_null<DocumentData*> document) {
 }
 
 void Stickers::setIsNotFaved(not_null<DocumentData*> document) {
+	session().readDeferredLocalData();
 	RemoveFromSet(setsRef(), document, FavedSetId);
 	session().local().writeFavedStickers();
 	notifyUpdated(StickersType::Stickers);
@@ -824,6 +849,7 @@ void Stickers::specialSetReceived(
 		uint64 hash,
 		const QVector<MTPStickerPack> &packs,
 		const QVector<MTPint> &usageDates) {
+	session().readDeferredLocalData();
 	auto &sets = setsRef();
 	auto it = sets.find(setId);
 
@@ -164,9 +164,7 @@ public:
 	[[nodiscard]] const StickersSetsOrder &maskSetsOrder() const {
 		return _maskSetsOrder;
 	}
-	[[nodiscard]] StickersSetsOrder &maskSetsOrderRef() {
-		return _maskSetsOrder;
-	}
+	[[nodiscard]] StickersSetsOrder &maskSetsOrderRef();
 	[[nodiscard]] const StickersSetsOrder &emojiSetsOrder() const {
 		return _emojiSetsOrder;
 	}
@@ -176,15 +174,11 @@ public:
 	[[nodiscard]] const StickersSetsOrder &featuredSetsOrder() const {
 		return _featuredSetsOrder;
 	}
-	[[nodiscard]] StickersSetsOrder &featuredSetsOrderRef() {
-		return _featuredSetsOrder;
-	}
+	[[nodiscard]] StickersSetsOrder &featuredSetsOrderRef();
 	[[nodiscard]] const StickersSetsOrder &featuredEmojiSetsOrder() const {
 		return _featuredEmojiSetsOrder;
 	}
-	[[nodiscard]] StickersSetsOrder &featuredEmojiSetsOrderRef() {
-		return _featuredEmojiSetsOrder;
-	}
+	[[nodiscard]] StickersSetsOrder &featuredEmojiSetsOrderRef();
 	[[nodiscard]] const StickersSetsOrder &archivedSetsOrder() const {
 		return _archivedSetsOrder;
 	}
@@ -200,9 +194,7 @@ public:
 	[[nodiscard]] const SavedGifs &savedGifs() const {
 		return _savedGifs;
 	}
-	[[nodiscard]] SavedGifs &savedGifsRef() {
-		return _savedGifs;
-	}
+	[[nodiscard]] SavedGifs &savedGifsRef();
 	void removeFromRecentSet(not_null<DocumentData*> document);
 
 	void addSavedGif(
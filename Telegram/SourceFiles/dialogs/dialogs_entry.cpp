@@ -377,10 +377,12 @@ void Entry::addChatListEntryByLetter(
 
 void Entry::updateChatListEntry() {
 	_flags &= ~Flag::UpdatePostponed;
+	++_chatListPaintVersion;
 	session().changes().entryUpdated(this, Data::EntryUpdate::Flag::Repaint);
 }
 
 void Entry::updateChatListEntryPostponed() {
+	++_chatListPaintVersion;
 	if (_flags & Flag::UpdatePostponed) {
 		return;
 	}
@@ -393,6 +395,7 @@ void Entry::updateChatListEntryPostponed() {
 }
 
 void Entry::updateChatListEntryHeight() {
+	++_chatListPaintVersion;
 	session().changes().entryUpdated(this, Data::EntryUpdate::Flag::Height);
 }
 
@@ -197,6 +197,11 @@ public:
 	void updateChatListEntry();
 	void updateChatListEntryPostponed();
 	void updateChatListEntryHeight();
+
+	// Changes each time the chat list row of this entry needs a repaint.
+	[[nodiscard]] uint32 chatListPaintVersion() const {
+		return _chatListPaintVersion;
+	}
 	[[nodiscard]] bool isPinnedDialog(FilterId filterId) const {
 		return lookupPinnedIndex(filterId) != 0;
 	}
@@ -284,6 +289,7 @@ private:
 	mutable Ui::PeerBadge _chatListPeerBadge;
 	mutable Ui::Text::String _chatListNameText;
 	mutable int _chatListNameVersion = 0;
+	uint32 _chatListPaintVersion = 0;
 	TimeId _timeId = 0;
 	Flags _flags;
 
@@ -19,11 +19,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "dialogs/dialogs_search_tags.h"
 #include "history/view/history_view_chat_preview.h"
 #include "history/view/history_view_context_menu.h"
+#include "history/view/history_view_send_action.h"
 #include "history/history.h"
 #include "history/history_item.h"
 #include "core/application.h"
 #include "core/click_handler_types.h"
 #include "core/shortcuts.h"
+#include "core/startup_trace.h"
 #include "ui/widgets/buttons.h"
 #include "ui/widgets/popup_menu.h"
 #include "ui/widgets/scroll_area.h"
@@ -219,10 +221,12 @@ InnerWidget::InnerWidget(
 	style::PaletteChanged(
 	) | rpl::start_with_next([=] {
 		_topicJumpCache = nullptr;
+		_rowRasters.clear();
 	}, lifetime());
 
 	session().downloaderTaskFinished(
 	) | rpl::start_with_next([=] {
+		_rowRasters.clear();
 		update();
 	}, lifetime());
 
@@ -678,7 +682,15 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		// We translate painter down, but it'll be cropped below rect.
 		p.fillRect(rect(), context.currentBg);
 	});
+	const auto traceGuard = gsl::finally([&] {
+		if (Core::StartupTrace::Enabled()
+			&& _state == WidgetState::Default
+			&& !_shownList->empty()) {
+			Core::StartupTrace::Finish();
+		}
+	});
 	const auto paintRow = [&](
+			Painter &q,
 			not_null<Row*> row,
 			bool selected,
 			bool mayBeActive) {
@@ -704,8 +716,53 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 		context.topicJumpSelected = selected
 			&& _selectedTopicJump
 			&& (!_pressed || _pressedTopicJump);
-		Ui::RowPainter::Paint(p, row, validateVideoUserpic(row), context);
+		Ui::RowPainter::Paint(q, row, validateVideoUserpic(row), context);
+	};
+
+	// While the list is only scrolled the rows are painted from their
+	// rasters, which are valid while the entry paint version is the same.
+	// Any other paint is caused by a change, so it drops the rasters of
+	// the rows it paints, and the next scroll paint renders them again.
+	const auto useRowRasters = base::take(_rowRastersScrolled);
+	const auto paintRowCached = [&](not_null<Row*> row, bool selected) {
+		if (!useRowRasters || !rowRasterAllowed(row)) {
+			_rowRasters.remove(row->key());
+			paintRow(p, row, selected, true);
+			return;
+		}
+		const auto ratio = style::DevicePixelRatio();
+		const auto size = QSize(fullWidth, row->height()) * ratio;
+		const auto version = row->entry()->chatListPaintVersion();
+		const auto active = isRowActive(row, activeEntry);
+		auto &raster = _rowRasters[row->key()];
+
+		// The painter is translated to the row top here.
+		raster.top = qRound(p.transform().dy());
+		if (raster.image.size() != size
+			|| raster.version != version
+			|| raster.selected != selected
+			|| raster.active != active) {
+			if (raster.image.size() != size) {
+				raster.image = QImage(
+					size,
+					QImage::Format_ARGB32_Premultiplied);
+				raster.image.setDevicePixelRatio(ratio);
+			}
+			raster.version = version;
+			raster.selected = selected;
+			raster.active = active;
+			raster.image.fill(Qt::transparent);
+			auto q = Painter(&raster.image);
+			q.setInactive(videoPaused);
+			paintRow(q, row, selected, true);
+		}
+		p.drawImage(0, 0, raster.image);
 	};
+	const auto rowRastersGuard = gsl::finally([&] {
+		if (useRowRasters) {
+			pruneRowRasters();
+		}
+	});
 	if (_state == WidgetState::Default) {
 		const auto collapsedSkip = collapsedRowsOffset();
 		p.translate(0, collapsedSkip);
@@ -746,10 +803,10 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 					: 0;
 				if (xadd || yadd) {
 					p.translate(xadd, yadd);
-				}
-				paintRow(row, (row->key() == selected), true);
-				if (xadd || yadd) {
+					paintRow(p, row, (row->key() == selected), true);
 					p.translate(-xadd, -yadd);
+				} else {
+					paintRowCached(row, (row->key() == selected));
 				}
 			};
 
@@ -874,7 +931,7 @@ void InnerWidget::paintEvent(QPaintEvent *e) {
 					? (from == _filteredPressed)
 					: (from == _filteredSelected);
 				const auto row = _filterResults[from].row;
-				paintRow(row, selected, !activeEntry.fullId);
+				paintRow(p, row, selected, !activeEntry.fullId);
 				p.translate(0, row->height());
 			}
 		}
@@ -1007,6 +1064,33 @@ Ui::VideoUserpic *InnerWidget::validateVideoUserpic(
 	)).first->second.get();
 }
 
+void InnerWidget::pruneRowRasters() {
+	// Rows that may scroll back soon keep their rasters, because
+	// a scroll paints only the newly exposed strip of the list.
+	const auto distance = _visibleBottom - _visibleTop;
+	const auto from = _visibleTop - distance;
+	const auto till = _visibleBottom + distance;
+	for (auto i = begin(_rowRasters); i != end(_rowRasters);) {
+		const auto top = i->second.top;
+		const auto height = i->second.image.height()
+			/ i->second.image.devicePixelRatio();
+		if (top + height < from || top > till) {
+			i = _rowRasters.erase(i);
+		} else {
+			++i;
+		}
+	}
+}
+
+bool InnerWidget::rowRasterAllowed(not_null<Row*> row) {
+	// A reused raster would freeze the row animations until the refresh.
+	if (validateVideoUserpic(row) || row->cornerBadgeAnimating()) {
+		return false;
+	}
+	const auto thread = row->thread();
+	return !thread || !thread->sendActionPainter()->animating();
+}
+
 void InnerWidget::paintCollapsedRows(Painter &p, QRect clip) const {
 	auto index = 0;
 	const auto rowHeight = st::dialogsImportantBarHeight;
@@ -2106,6 +2190,7 @@ int InnerWidget::defaultRowTop(not_null<Row*> row) const {
 void InnerWidget::repaintDialogRow(
 		FilterId filterId,
 		not_null<Row*> row) {
+	_rowRasters.remove(row->key());
 	if (_state == WidgetState::Default) {
 		if (_filterId == filterId) {
 			if (const auto folder = row->folder()) {
@@ -2167,6 +2252,7 @@ void InnerWidget::updateDialogRow(
 		RowDescriptor row,
 		QRect updateRect,
 		UpdateRowSections sections) {
+	_rowRasters.remove(row.key);
 	if (IsServerMsgId(-row.fullId.msg)) {
 		if (const auto peer = row.key.peer()) {
 			if (const auto from = peer->migrateFrom()) {
@@ -2946,6 +3032,9 @@ rpl::producer<> InnerWidget::refreshHashtagsRequests() const {
 void InnerWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
+	if (_visibleTop != visibleTop) {
+		_rowRastersScrolled = true;
+	}
 	_visibleTop = visibleTop;
 	_visibleBottom = visibleBottom;
 	preloadRowsData();
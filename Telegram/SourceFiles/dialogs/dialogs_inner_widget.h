@@ -406,6 +406,8 @@ private:
 
 	Ui::VideoUserpic *validateVideoUserpic(not_null<Row*> row);
 	Ui::VideoUserpic *validateVideoUserpic(not_null<History*> history);
+	[[nodiscard]] bool rowRasterAllowed(not_null<Row*> row);
+	void pruneRowRasters();
 
 	Row *shownRowByKey(Key key);
 	void clearSearchResults(bool clearPeerSearchResults = true);
@@ -474,6 +476,16 @@ private:
 	int _visibleBottom = 0;
 	QString _filter, _hashtagFilter;
 
+	struct RowRaster {
+		QImage image;
+		int top = 0;
+		uint32 version = 0;
+		bool selected = false;
+		bool active = false;
+	};
+	base::flat_map<Key, RowRaster> _rowRasters;
+	bool _rowRastersScrolled = false;
+
 	std::vector<std::unique_ptr<HashtagResult>> _hashtagResults;
 	int _hashtagSelected = -1;
 	int _hashtagPressed = -1;
@@ -701,6 +701,11 @@ bool Row::topicJumpRipple() const {
 	return _topicJumpRipple != 0;
 }
 
+bool Row::cornerBadgeAnimating() const {
+	return _cornerBadgeUserpic
+		&& !_cornerBadgeUserpic->layersManager.isFinished();
+}
+
 FakeRow::FakeRow(
 	Key searchInChat,
 	not_null<HistoryItem*> item,
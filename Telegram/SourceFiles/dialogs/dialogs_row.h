@@ -115,6 +115,7 @@ public:
 		Fn<void()> updateCallback);
 	void clearTopicJumpRipple();
 	[[nodiscard]] bool topicJumpRipple() const;
+	[[nodiscard]] bool cornerBadgeAnimating() const;
 
 	[[nodiscard]] Key key() const {
 		return _id;
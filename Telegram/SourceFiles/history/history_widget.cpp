@@ -192,6 +192,8 @@ constexpr auto kSaveDraftTimeout = crl::time(1000);
 constexpr auto kSaveDraftAnywayTimeout = 5 * crl::time(1000);
 constexpr auto kSaveCloudDraftIdleTimeout = 14 * crl::time(1000);
 constexpr auto kRefreshSlowmodeLabelTimeout = crl::time(200);
+constexpr auto kSupportPreloadChatsCount = 3;
+constexpr auto kSupportPreloadRequestsCount = 2;
 constexpr auto kCommonModifiers = 0
 	| Qt::ShiftModifier
 	| Qt::MetaModifier
@@ -982,6 +984,21 @@ HistoryWidget::HistoryWidget(
 		) | rpl::start_with_next([=] {
 			crl::on_main(this, [=] { checkSupportPreload(true); });
 		}, lifetime());
+
+		// A preloaded chat that was unloaded since is not ready anymore.
+		session().data().historyUnloaded(
+		) | rpl::start_with_next([=](not_null<const History*> history) {
+			const auto i = ranges::find(
+				_supportPreloads,
+				history,
+				[](const auto &entry) { return entry.first.get(); });
+			if (i != end(_supportPreloads)
+				&& !i->second.requestId
+				&& i->second.ready) {
+				_supportPreloads.erase(i);
+				crl::on_main(this, [=] { checkSupportPreload(true); });
+			}
+		}, lifetime());
 	}
 
 	Core::App().materializeLocalDraftsRequests(
@@ -2576,7 +2593,7 @@ void HistoryWidget::setHistory(History *history) {
 	if (_history) {
 		unregisterDraftSources();
 		clearAllLoadRequests();
-		clearSupportPreloadRequest();
+		clearSupportPreloadRequest(history);
 		const auto wasHistory = base::take(_history);
 		const auto wasMigrated = base::take(_migrated);
 		unloadHeavyViewParts(wasHistory);
@@ -2726,14 +2743,47 @@ void HistoryWidget::clearDelayedShowAtRequest() {
 	}
 }
 
-void HistoryWidget::clearSupportPreloadRequest() {
+void HistoryWidget::clearSupportPreloadRequest(History *showing) {
 	Expects(_history != nullptr);
 
-	if (_supportPreloadRequest) {
+	_supportSwitchStarted = 0;
+	if (!showing) {
 		auto &histories = _history->owner().histories();
-		histories.cancelRequest(_supportPreloadRequest);
-		_supportPreloadRequest = 0;
+		for (const auto &[history, preload] : base::take(_supportPreloads)) {
+			if (preload.requestId) {
+				histories.cancelRequest(preload.requestId);
+			}
+		}
+		return;
+	} else if (!session().supportMode()) {
+		return;
+	}
+	const auto now = crl::now();
+	const auto i = _supportPreloads.find(showing);
+	if (i == end(_supportPreloads)) {
+		_supportSwitchStarted = now;
+		return;
+	}
+	const auto &preload = i->second;
+	if (preload.requestId) {
+		// The widget loads the history itself, the preload result
+		// would only clear it once again when it arrives.
+		showing->owner().histories().cancelRequest(preload.requestId);
+		_supportSwitchStarted = now;
+		DEBUG_LOG(("Support Preload: switched to a chat %1 ms "
+			"after its preload started, cancelled."
+			).arg(now - preload.started));
+	} else if (!preload.ready) {
+		_supportSwitchStarted = now;
+		DEBUG_LOG(("Support Preload: switched to a chat "
+			"with a failed preload."));
+	} else {
+		DEBUG_LOG(("Support Preload: switched to a preloaded chat, "
+			"preloaded in %1 ms, ready for %2 ms."
+			).arg(preload.ready - preload.started
+			).arg(now - preload.ready));
 	}
+	_supportPreloads.erase(i);
 }
 
 void HistoryWidget::clearAllLoadRequests() {
@@ -3510,6 +3560,12 @@ void HistoryWidget::messagesReceived(
 		historyLoaded();
 	}
 	if (session().supportMode()) {
+		if (_supportSwitchStarted
+			&& !_firstLoadRequest
+			&& !_delayedShowAtRequest) {
+			DEBUG_LOG(("Support Preload: chat ready in %1 ms after switch."
+				).arg(crl::now() - base::take(_supportSwitchStarted)));
+		}
 		crl::on_main(this, [=] { checkSupportPreload(); });
 	}
 }
@@ -3900,28 +3956,85 @@ void HistoryWidget::checkSupportPreload(bool force) {
 		|| _firstLoadRequest
 		|| _preloadRequest
 		|| _preloadDownRequest
-		|| (_supportPreloadRequest && !force)
 		|| controller()->activeChatEntryCurrent().key.history() != _history) {
 		return;
 	}
-
+	// Collect the chats the operator is going to switch to next.
 	const auto setting = session().settings().supportSwitch();
 	const auto command = Support::GetSwitchCommand(setting);
-	const auto descriptor = !command
-		? Dialogs::RowDescriptor()
-		: (*command == Shortcuts::Command::ChatNext)
-		? controller()->resolveChatNext()
-		: controller()->resolveChatPrevious();
-	auto history = descriptor.key.history();
-	if (!history || _supportPreloadHistory == history) {
-		return;
-	}
-	clearSupportPreloadRequest();
-	_supportPreloadHistory = history;
-	_supportPreloadRequest = Support::SendPreloadRequest(history, [=] {
-		_supportPreloadRequest = 0;
-		_supportPreloadHistory = nullptr;
-		crl::on_main(this, [=] { checkSupportPreload(); });
+	auto queue = std::vector<not_null<History*>>();
+	auto from = Dialogs::RowDescriptor();
+	while (command && int(queue.size()) < kSupportPreloadChatsCount) {
+		from = (*command == Shortcuts::Command::ChatNext)
+			? controller()->resolveChatNext(from)
+			: controller()->resolveChatPrevious(from);
+		const auto history = from.key.history();
+		if (!history || history == _history) {
+			break;
+		}
+		const auto already = ranges::contains(
+			queue,
+			not_null<History*>(history));
+		if (already) {
+			break;
+		}
+		queue.push_back(history);
+	}
+
+	auto &histories = session().data().histories();
+	for (auto i = begin(_supportPreloads); i != end(_supportPreloads);) {
+		if (ranges::contains(queue, i->first)) {
+			++i;
+			continue;
+		} else if (const auto requestId = i->second.requestId) {
+			histories.cancelRequest(requestId);
+		}
+		i = _supportPreloads.erase(i);
+	}
+
+	// The preloads that fell out of the queue are cancelled above even
+	// if the limit doesn't allow to start any new ones right now.
+	const auto inFlight = int(ranges::count_if(
+		_supportPreloads,
+		[](const auto &entry) { return (entry.second.requestId != 0); }));
+	if (!force && inFlight > 0) {
+		return;
+	}
+	auto left = kSupportPreloadRequestsCount - inFlight;
+	for (const auto &history : queue) {
+		if (left <= 0) {
+			break;
+		} else if (!_supportPreloads.contains(history)) {
+			sendSupportPreloadRequest(history);
+			--left;
+		}
+	}
+}
+
+void HistoryWidget::sendSupportPreloadRequest(not_null<History*> history) {
+	const auto started = crl::now();
+	const auto done = crl::guard(this, [=](bool success) {
+		const auto i = _supportPreloads.find(history);
+		if (i != end(_supportPreloads)) {
+			// A failed entry is kept so that the chat is not requested
+			// again while it stays in the queue.
+			i->second.requestId = 0;
+			if (success) {
+				i->second.ready = crl::now();
+				DEBUG_LOG(("Support Preload: chat preloaded in %1 ms."
+					).arg(i->second.ready - i->second.started));
+			}
+		}
+		crl::on_main(this, [=] { checkSupportPreload(true); });
+	});
+	const auto retry = crl::guard(this, [=] {
+		_supportPreloads.remove(history);
+		crl::on_main(this, [=] { checkSupportPreload(true); });
+	});
+	const auto requestId = Support::SendPreloadRequest(history, done, retry);
+	_supportPreloads.emplace(history, SupportPreload{
+		.requestId = requestId,
+		.started = started,
 	});
 }
 
@@ -239,7 +239,7 @@ public:
 		Ui::ReportReason reason,
 		Fn<void(MessageIdsList)> callback);
 	void clearAllLoadRequests();
-	void clearSupportPreloadRequest();
+	void clearSupportPreloadRequest(History *showing);
 	void clearDelayedShowAtRequest();
 	void clearDelayedShowAt();
 
@@ -620,6 +620,7 @@ private:
 	[[nodiscard]] bool hasSilentToggle() const;
 
 	void checkSupportPreload(bool force = false);
+	void sendSupportPreloadRequest(not_null<History*> history);
 	void handleSupportSwitch(not_null<History*> updated);
 
 	[[nodiscard]] bool isRecording() const;
@@ -715,8 +716,13 @@ private:
 	int _delayedShowAtMsgHighlightPartOffsetHint = 0;
 	int _delayedShowAtRequest = 0; // Not real mtpRequestId.
 
-	History *_supportPreloadHistory = nullptr;
-	int _supportPreloadRequest = 0; // Not real mtpRequestId.
+	struct SupportPreload {
+		int requestId = 0; // Not real mtpRequestId.
+		crl::time started = 0;
+		crl::time ready = 0;
+	};
+	base::flat_map<not_null<History*>, SupportPreload> _supportPreloads;
+	crl::time _supportSwitchStarted = 0;
 
 	object_ptr<HistoryView::TopBarWidget> _topBar;
 	object_ptr<Ui::ContinuousScroll> _scroll;
@@ -54,6 +54,12 @@ void SendActionPainter::setTopic(Data::ForumTopic *topic) {
 	_topic = topic;
 }
 
+bool SendActionPainter::animating() const {
+	return !_typing.empty()
+		|| !_speaking.empty()
+		|| !_sendActions.empty();
+}
+
 bool SendActionPainter::updateNeedsAnimating(
 		not_null<UserData*> user,
 		const MTPSendMessageAction &action) {
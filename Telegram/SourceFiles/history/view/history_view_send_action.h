@@ -57,6 +57,8 @@ public:
 		const MTPSendMessageAction &action);
 	void clear(not_null<UserData*> from);
 
+	[[nodiscard]] bool animating() const;
+
 private:
 	const not_null<History*> _history;
 	const MsgId _rootId = 0;
@@ -29,6 +29,7 @@ constexpr auto kEnoughForTranslation = 6;
 constexpr auto kMaxCheckInBunch = 100;
 constexpr auto kRequestLengthLimit = 24 * 1024;
 constexpr auto kRequestCountLimit = 20;
+constexpr auto kRecognizedCacheLimit = 2048;
 
 } // namespace
 
@@ -135,11 +136,12 @@ bool TranslateTracker::add(
 		return true;
 	}
 	const auto &text = item->originalText().text;
+	const auto known = _trackingLanguage.current()
+		? lookupRecognized(id, text)
+		: std::nullopt;
 	_itemsForRecognize.emplace(id, ItemForRecognize{
 		.generation = _generation,
-		.id = (_trackingLanguage.current()
-			? Platform::Language::Recognize(text)
-			: MaybeLanguageId{ text }),
+		.id = (known ? MaybeLanguageId{ *known } : MaybeLanguageId{ text }),
 	});
 	++_addedInBunch;
 	return true;
@@ -161,6 +163,7 @@ void TranslateTracker::finishBunch() {
 		_addedInBunch = -1;
 		applyLimit();
 		if (_trackingLanguage.current()) {
+			recognizeCollected();
 			checkRecognized();
 		}
 	}
@@ -336,9 +339,109 @@ void TranslateTracker::applyLimit() {
 }
 
 void TranslateTracker::recognizeCollected() {
+	if (_recognizing) {
+		return;
+	}
+	auto texts = std::vector<TextToRecognize>();
 	for (auto &[id, entry] : _itemsForRecognize) {
 		if (const auto text = std::get_if<QString>(&entry.id)) {
-			entry.id = Platform::Language::Recognize(*text);
+			if (const auto known = lookupRecognized(id, *text)) {
+				entry.id = *known;
+			} else {
+				texts.push_back({ id, *text });
+			}
+		}
+	}
+	if (texts.empty()) {
+		return;
+	}
+
+	// Recognition may take a while for long texts, so the whole batch
+	// is recognized on a worker thread and is applied back on main.
+	_recognizing = true;
+	crl::async([
+		=,
+		texts = std::move(texts),
+		weak = base::make_weak(this)
+	]() mutable {
+		auto ids = std::vector<LanguageId>();
+		ids.reserve(texts.size());
+		for (const auto &entry : texts) {
+			ids.push_back(Platform::Language::Recognize(entry.text));
+		}
+		crl::on_main(weak, [
+			=,
+			texts = std::move(texts),
+			ids = std::move(ids)
+		]() mutable {
+			recognizeDone(std::move(texts), std::move(ids));
+		});
+	});
+}
+
+void TranslateTracker::recognizeDone(
+		std::vector<TextToRecognize> &&texts,
+		std::vector<LanguageId> &&ids) {
+	Expects(texts.size() == ids.size());
+
+	_recognizing = false;
+	for (auto i = 0, count = int(texts.size()); i != count; ++i) {
+		const auto &[itemId, text] = texts[i];
+		rememberRecognized(itemId, text, ids[i]);
+
+		const auto j = _itemsForRecognize.find(itemId);
+		if (j == end(_itemsForRecognize)) {
+			continue;
+		} else if (const auto now = std::get_if<QString>(&j->second.id)) {
+			if (*now == text) {
+				j->second.id = ids[i];
+			}
+		}
+	}
+	if (_trackingLanguage.current()) {
+		recognizeCollected();
+		checkRecognized();
+	}
+}
+
+std::optional<LanguageId> TranslateTracker::lookupRecognized(
+		FullMsgId itemId,
+		const QString &text) {
+	const auto i = _recognized.find(itemId);
+	if (i == end(_recognized) || i->second.textHash != size_t(qHash(text))) {
+		return std::nullopt;
+	}
+	i->second.used = ++_recognizedUsed;
+	return i->second.id;
+}
+
+void TranslateTracker::rememberRecognized(
+		FullMsgId itemId,
+		const QString &text,
+		LanguageId id) {
+	_recognized[itemId] = RecognizedLanguage{
+		.textHash = size_t(qHash(text)),
+		.id = id,
+		.used = ++_recognizedUsed,
+	};
+	if (_recognized.size() <= kRecognizedCacheLimit) {
+		return;
+	}
+
+	// Drop the least recently used quarter of the cache at once.
+	auto used = ranges::views::all(
+		_recognized
+	) | ranges::views::transform([](const auto &pair) {
+		return pair.second.used;
+	}) | ranges::to_vector;
+	const auto cut = begin(used) + (kRecognizedCacheLimit / 4);
+	ranges::nth_element(used, cut);
+	const auto threshold = *cut;
+	for (auto i = begin(_recognized); i != end(_recognized);) {
+		if (i->second.used < threshold) {
+			i = _recognized.erase(i);
+		} else {
+			++i;
 		}
 	}
 }
@@ -358,6 +461,9 @@ void TranslateTracker::checkRecognized(const std::vector<LanguageId> &skip) {
 	if (!_trackingLanguage.current()) {
 		_history->translateOfferFrom({});
 		return;
+	} else if (_recognizing) {
+		// Will be checked when the current batch is recognized.
+		return;
 	}
 	auto languages = base::flat_map<LanguageId, int>();
 	for (const auto &[id, entry] : _itemsForRecognize) {
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #pragma once
 
+#include "base/weak_ptr.h"
 #include "spellcheck/spellcheck_types.h"
 
 class History;
@@ -16,7 +17,7 @@ namespace HistoryView {
 
 class Element;
 
-class TranslateTracker final {
+class TranslateTracker final : public base::has_weak_ptr {
 public:
 	explicit TranslateTracker(not_null<History*> history);
 	~TranslateTracker();
@@ -41,10 +42,29 @@ private:
 	struct ItemToRequest {
 		int length = 0;
 	};
+	struct RecognizedLanguage {
+		size_t textHash = 0;
+		LanguageId id;
+		uint64 used = 0;
+	};
+	struct TextToRecognize {
+		FullMsgId itemId;
+		QString text;
+	};
 
 	void setup();
 	bool add(not_null<HistoryItem*> item, bool skipDependencies);
 	void recognizeCollected();
+	void recognizeDone(
+		std::vector<TextToRecognize> &&texts,
+		std::vector<LanguageId> &&ids);
+	[[nodiscard]] std::optional<LanguageId> lookupRecognized(
+		FullMsgId itemId,
+		const QString &text);
+	void rememberRecognized(
+		FullMsgId itemId,
+		const QString &text,
+		LanguageId id);
 	void trackSkipLanguages();
 	void checkRecognized();
 	void checkRecognized(const std::vector<LanguageId> &skip);
@@ -62,6 +82,9 @@ private:
 	rpl::variable<bool> _trackingLanguage = false;
 	base::flat_map<FullMsgId, ItemForRecognize> _itemsForRecognize;
 	uint64 _generation = 0;
+	base::flat_map<FullMsgId, RecognizedLanguage> _recognized;
+	uint64 _recognizedUsed = 0;
+	bool _recognizing = false;
 	LanguageId _bunchTranslatedTo;
 	int _limit = 0;
 	int _addedInBunch = -1;
@@ -48,6 +48,7 @@ public:
 		int outerWidth) const;
 
 	void paintFloatingHeader(Painter &p, int visibleTop, int outerWidth);
+	void preloadHeavyParts(int from, int till) const;
 
 private:
 	[[nodiscard]] int headerHeight() const;
@@ -634,11 +634,12 @@ auto ListWidget::foundItemInSection(
 void ListWidget::visibleTopBottomUpdated(
 		int visibleTop,
 		int visibleBottom) {
-	_visibleTop = visibleTop;
+	const auto wasVisibleTop = std::exchange(_visibleTop, visibleTop);
 	_visibleBottom = visibleBottom;
 
 	checkMoveToOtherViewer();
 	clearHeavyItems();
+	preloadHeavyItems(wasVisibleTop);
 
 	if (_dateBadge->goodType) {
 		updateDateBadgeFor(_visibleTop);
@@ -743,6 +744,24 @@ void ListWidget::clearHeavyItems() {
 	}
 }
 
+void ListWidget::preloadHeavyItems(int wasVisibleTop) {
+	// Start loading thumbnails for the screen we're scrolling to.
+	// It is exactly the band that clearHeavyItems() keeps loaded.
+	const auto visibleHeight = _visibleBottom - _visibleTop;
+	if (!visibleHeight || _visibleTop == wasVisibleTop) {
+		return;
+	}
+	const auto down = (_visibleTop > wasVisibleTop);
+	const auto from = down ? _visibleBottom : (_visibleTop - visibleHeight);
+	const auto till = down ? (_visibleBottom + visibleHeight) : _visibleTop;
+	const auto fromSectionIt = findSectionAfterTop(from);
+	const auto tillSectionIt = findSectionAfterBottom(fromSectionIt, till);
+	for (auto it = fromSectionIt; it != tillSectionIt; ++it) {
+		const auto top = it->top();
+		it->preloadHeavyParts(from - top, till - top);
+	}
+}
+
 ListScrollTopState ListWidget::countScrollState() const {
 	if (_sections.empty() || _visibleTop <= 0) {
 		return {};
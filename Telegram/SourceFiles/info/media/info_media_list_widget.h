@@ -270,6 +270,7 @@ private:
 	void validateTrippleClickStartTime();
 	void checkMoveToOtherViewer();
 	void clearHeavyItems();
+	void preloadHeavyItems(int wasVisibleTop);
 
 	void setActionBoxWeak(QPointer<Ui::BoxContent> box);
 
@@ -34,6 +34,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/unixtime.h"
 #include "window/window_session_controller.h"
 #include "main/main_session.h"
+#include "main/session/session_timer_wheel.h"
 #include "settings/settings_premium.h"
 #include "chat_helpers/stickers_lottie.h"
 #include "apiwrap.h"
@@ -331,8 +332,7 @@ Cover::Cover(
 	: nullptr)
 , _name(this, _st.name)
 , _status(this, _st.status)
-, _showLastSeen(this, tr::lng_status_lastseen_when(), _st.showLastSeen)
-, _refreshStatusTimer([this] { refreshStatusText(); }) {
+, _showLastSeen(this, tr::lng_status_lastseen_when(), _st.showLastSeen) {
 	_peer->updateFull();
 
 	_name->setSelectable(true);
@@ -596,7 +596,11 @@ void Cover::refreshStatusText() {
 			const auto showOnline = Data::OnlineTextActive(user, currentTime);
 			const auto updateIn = Data::OnlineChangeTimeout(user, currentTime);
 			if (showOnline) {
-				_refreshStatusTimer.callOnce(updateIn);
+				_refreshStatusLifetime = user->session().timerWheel().after(
+					updateIn
+				) | rpl::start_with_next([=] {
+					refreshStatusText();
+				});
 			}
 			return showOnline
 				? Ui::Text::Colorized(result)
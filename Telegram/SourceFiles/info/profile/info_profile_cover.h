@@ -157,7 +157,7 @@ private:
 	object_ptr<Ui::FlatLabel> _status = { nullptr };
 	object_ptr<Ui::RoundButton> _showLastSeen = { nullptr };
 	//object_ptr<CoverDropArea> _dropArea = { nullptr };
-	base::Timer _refreshStatusTimer;
+	rpl::lifetime _refreshStatusLifetime;
 
 	rpl::event_stream<Section> _showSection;
 
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "iv/iv_data.h"
 
 #include "iv/iv_prepare.h"
+#include "lang/lang_keys.h"
 #include "webview/webview_interface.h"
 
 #include <QtCore/QRegularExpression>
@@ -16,8 +17,64 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 namespace Iv {
 namespace {
 
+constexpr auto kPreparedCacheSize = 8;
+
 bool FailureRecorded/* = false*/;
 
+struct PreparedKey {
+	uint64 pageId = 0;
+	int32 pageHash = 0;
+	int views = 0;
+	bool partial = false;
+	QString langId;
+
+	friend inline bool operator==(
+			const PreparedKey &a,
+			const PreparedKey &b) = default;
+};
+
+// Reopening the same article, for example after following a link
+// back, gives the same html, so we keep the last few results.
+class PreparedCache final {
+public:
+	[[nodiscard]] std::optional<Prepared> find(const PreparedKey &key) {
+		QMutexLocker lock(&_mutex);
+		const auto i = ranges::find(_list, key, &Entry::key);
+		if (i == end(_list)) {
+			return std::nullopt;
+		}
+		std::rotate(begin(_list), i, i + 1);
+		return _list.front().prepared;
+	}
+
+	void remember(const PreparedKey &key, const Prepared &prepared) {
+		QMutexLocker lock(&_mutex);
+		const auto i = ranges::find(_list, key, &Entry::key);
+		if (i != end(_list)) {
+			_list.erase(i);
+		}
+		_list.insert(begin(_list), Entry{ key, prepared });
+		if (_list.size() > kPreparedCacheSize) {
+			_list.pop_back();
+		}
+	}
+
+private:
+	struct Entry {
+		PreparedKey key;
+		Prepared prepared;
+	};
+
+	QMutex _mutex;
+	std::vector<Entry> _list;
+
+};
+
+[[nodiscard]] PreparedCache &SharedPreparedCache() {
+	static auto result = PreparedCache();
+	return result;
+}
+
 } // namespace
 
 QByteArray GeoPointId(Geo point) {
@@ -48,6 +105,7 @@ Geo GeoPointFromId(QByteArray data) {
 Data::Data(const MTPDwebPage &webpage, const MTPPage &page)
 : _source(std::make_unique<Source>(Source{
 	.pageId = webpage.vid().v,
+	.pageHash = webpage.vhash().v,
 	.page = page,
 	.webpagePhoto = (webpage.vphoto()
 		? *webpage.vphoto()
@@ -78,8 +136,23 @@ void Data::updateCachedViews(int cachedViews) {
 }
 
 void Data::prepare(const Options &options, Fn<void(Prepared)> done) const {
-	crl::async([source = *_source, options, done = std::move(done)] {
-		done(Prepare(source, options));
+	// Dates in the page are formatted for the current language.
+	const auto key = PreparedKey{
+		.pageId = _source->pageId,
+		.pageHash = _source->pageHash,
+		.views = _source->updatedCachedViews,
+		.partial = partial(),
+		.langId = Lang::Id(),
+	};
+	crl::async([=, source = *_source, done = std::move(done)] {
+		auto &cache = SharedPreparedCache();
+		if (auto cached = cache.find(key)) {
+			done(*std::move(cached));
+			return;
+		}
+		auto result = Prepare(source, options);
+		cache.remember(key, result);
+		done(std::move(result));
 	});
 }
 
@@ -14,6 +14,7 @@ struct Prepared;
 
 struct Source {
 	uint64 pageId = 0;
+	int32 pageHash = 0;
 	MTPPage page;
 	std::optional<MTPPhoto> webpagePhoto;
 	std::optional<MTPDocument> webpageDocument;
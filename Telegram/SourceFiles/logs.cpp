@@ -12,8 +12,16 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/launcher.h"
 #include "mtproto/facade.h"
 
+#include <condition_variable>
+#include <thread>
+
 namespace {
 
+// Debug, tcp and mtp entries are written by a background thread.
+// They may be lost only for the last kDebugFlushTimeout on a crash.
+constexpr auto kDebugFlushTimeout = std::chrono::milliseconds(250);
+constexpr auto kDebugFlushBytes = 256 * 1024;
+
 std::atomic<int> ThreadCounter/* = 0*/;
 thread_local bool WritingEntryFlag/* = false*/;
 
@@ -79,6 +87,10 @@ public:
 		}
 	}
 
+	~LogsDataFields() {
+		stopWriter();
+	}
+
 	bool openMain() {
 		return reopen(LogDataMain, 0, u"start"_q);
 	}
@@ -111,12 +123,13 @@ public:
 	}
 
 	void write(LogDataType type, const QString &msg) {
+		if (type != LogDataMain) {
+			writeDebug(type, msg);
+			return;
+		}
 		QMutexLocker lock(_logsMutex(type));
 		WritingEntryScope scope;
 
-		if (type != LogDataMain) {
-			reopenDebug();
-		}
 		const auto file = files[type].get();
 		if (!file || !file->isOpen()) {
 			return;
@@ -125,8 +138,94 @@ public:
 		file->flush();
 	}
 
+	void flushDebug() {
+		if (!writerStarted) {
+			return;
+		}
+		WritingEntryScope scope;
+		writePending();
+	}
+
 private:
+	void writeDebug(LogDataType type, const QString &msg) {
+		auto wake = false;
+		{
+			QMutexLocker lock(_logsMutex(type));
+			pending[type].append(msg.toUtf8());
+			wake = (pending[type].size() >= kDebugFlushBytes);
+		}
+		if (!writerStarted) {
+			startWriter();
+		}
+		if (wake) {
+			writerCondition.notify_one();
+		}
+	}
+
+	void startWriter() {
+		std::unique_lock<std::mutex> lock(writerMutex);
+		if (writerStarted || writerStopped) {
+			return;
+		}
+		writerStarted = true;
+		writer = std::thread([=] {
+			WritingEntryScope scope;
+			auto lock = std::unique_lock<std::mutex>(writerMutex);
+			while (!writerStopped) {
+				writerCondition.wait_for(lock, kDebugFlushTimeout);
+				lock.unlock();
+				writePending();
+				lock.lock();
+			}
+		});
+	}
+
+	void stopWriter() {
+		{
+			std::unique_lock<std::mutex> lock(writerMutex);
+			writerStopped = true;
+		}
+		writerCondition.notify_one();
+		if (!writerStarted) {
+			return;
+		}
+		writer.join();
+		WritingEntryScope scope;
+		writePending();
+	}
+
+	void writePending() {
+		std::unique_lock<std::mutex> lock(writeFilesMutex);
+		QByteArray data[LogDataCount];
+		auto empty = true;
+		for (auto type = int(LogDataDebug); type != LogDataCount; ++type) {
+			QMutexLocker guard(_logsMutex(LogDataType(type)));
+			std::swap(data[type], pending[type]);
+			empty = empty && data[type].isEmpty();
+		}
+		if (empty) {
+			return;
+		}
+		reopenDebug();
+		for (auto type = int(LogDataDebug); type != LogDataCount; ++type) {
+			const auto file = files[type].get();
+			if (data[type].isEmpty() || !file || !file->isOpen()) {
+				continue;
+			}
+			file->write(data[type]);
+			file->flush();
+		}
+	}
+
 	std::unique_ptr<QFile> files[LogDataCount];
+	QByteArray pending[LogDataCount];
+
+	std::thread writer;
+	std::mutex writerMutex;
+	std::mutex writeFilesMutex;
+	std::condition_variable writerCondition;
+	std::atomic<bool> writerStarted = false;
+	bool writerStopped = false;
 
 	int32 part = -1;
 
@@ -489,6 +588,7 @@ void multipleInstances() {
 void closeMain() {
 	LOG(("Explicitly closing main log and finishing crash handlers."));
 	if (LogsData) {
+		LogsData->flushDebug();
 		LogsData->closeMain();
 	}
 }
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/platform/base_platform_info.h"
 #include "core/application.h"
+#include "core/startup_trace.h"
 #include "storage/storage_account.h"
 #include "storage/storage_domain.h" // Storage::StartResult.
 #include "storage/serialize_common.h"
@@ -71,6 +72,7 @@ Storage::Domain &Account::domainLocal() const {
 
 std::unique_ptr<MTP::Config> Account::prepareToStart(
 		std::shared_ptr<MTP::AuthKey> localKey) {
+	const auto span = Core::StartupTrace::Span("Storage::Account::start");
 	return _local->start(std::move(localKey));
 }
 
@@ -187,6 +189,7 @@ void Account::createSession(
 	Expects(_session == nullptr);
 	Expects(_sessionValue.current() == nullptr);
 
+	const auto span = Core::StartupTrace::Span("Main::Session");
 	_session = std::make_unique<Session>(this, user, std::move(settings));
 	if (!serialized.isEmpty()) {
 		local().readSelf(_session.get(), serialized, streamVersion);
@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/core_settings.h"
 #include "core/shortcuts.h"
 #include "core/crash_reports.h"
+#include "core/startup_trace.h"
 #include "main/main_account.h"
 #include "main/main_session.h"
 #include "data/data_session.h"
@@ -20,6 +21,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "mtproto/mtproto_dc_options.h"
 #include "storage/storage_domain.h"
 #include "storage/storage_account.h"
+#include "storage/storage_encryption.h"
 #include "storage/localstorage.h"
 #include "export/export_settings.h"
 #include "window/notifications_manager.h"
@@ -59,6 +61,30 @@ Domain::Domain(const QString &dataName)
 
 Domain::~Domain() = default;
 
+void Domain::openSharedCaches(
+		const Storage::Cache::Database::Settings &settings,
+		const Storage::Cache::Database::Settings &settingsBig) {
+	if (_sharedCache || !_local->hasSharedCache()) {
+		return;
+	}
+	_sharedCache = Core::App().databases().get(
+		_local->sharedCachePath(),
+		settings);
+	_sharedCache->open(_local->sharedCacheKey());
+	_sharedCacheBigFile = Core::App().databases().get(
+		_local->sharedCacheBigFilePath(),
+		settingsBig);
+	_sharedCacheBigFile->open(_local->sharedCacheKey());
+}
+
+Storage::Cache::Database *Domain::sharedCache() const {
+	return _sharedCache.get();
+}
+
+Storage::Cache::Database *Domain::sharedCacheBigFile() const {
+	return _sharedCacheBigFile.get();
+}
+
 bool Domain::started() const {
 	return !_accounts.empty();
 }
@@ -66,6 +92,7 @@ bool Domain::started() const {
 Storage::StartResult Domain::start(const QByteArray &passcode) {
 	Expects(!started());
 
+	const auto span = Core::StartupTrace::Span("Storage::Domain::start");
 	const auto result = _local->start(passcode);
 	if (result == Storage::StartResult::Success) {
 		activateAfterStarting();
@@ -9,6 +9,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 #include "base/timer.h"
 #include "base/weak_ptr.h"
+#include "storage/storage_databases.h"
 
 namespace Storage {
 class Domain;
@@ -49,6 +50,15 @@ public:
 		return *_local;
 	}
 
+	// Stickers and custom emoji are the same for all the accounts, so
+	// their files and rendered frames are cached once for the domain.
+	// The first session to open them provides the limits.
+	void openSharedCaches(
+		const Storage::Cache::Database::Settings &settings,
+		const Storage::Cache::Database::Settings &settingsBig);
+	[[nodiscard]] Storage::Cache::Database *sharedCache() const;
+	[[nodiscard]] Storage::Cache::Database *sharedCacheBigFile() const;
+
 	[[nodiscard]] auto accounts() const
 		-> const std::vector<AccountWithIndex> &;
 	[[nodiscard]] std::vector<not_null<Account*>> orderedAccounts() const;
@@ -94,6 +104,10 @@ private:
 	const QString _dataName;
 	const std::unique_ptr<Storage::Domain> _local;
 
+	// Destroyed after the accounts that use them.
+	Storage::DatabasePointer _sharedCache;
+	Storage::DatabasePointer _sharedCacheBigFile;
+
 	std::vector<AccountWithIndex> _accounts;
 	rpl::event_stream<> _accountsChanges;
 	rpl::variable<Account*> _active = nullptr;
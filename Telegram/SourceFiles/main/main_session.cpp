@@ -16,6 +16,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_session_settings.h"
 #include "main/main_app_config.h"
 #include "main/session/send_as_peers.h"
+#include "main/session/session_timer_wheel.h"
 #include "mtproto/mtproto_config.h"
 #include "chat_helpers/stickers_emoji_pack.h"
 #include "chat_helpers/stickers_dice_pack.h"
@@ -49,6 +50,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "support/support_helper.h"
 #include "lang/lang_keys.h"
 #include "core/application.h"
+#include "core/startup_trace.h"
 #include "ui/text/text_utilities.h"
 #include "ui/layers/generic_box.h"
 #include "styles/style_layers.h"
@@ -95,6 +97,7 @@ Session::Session(
 , _account(account)
 , _settings(std::move(settings))
 , _changes(std::make_unique<Data::Changes>(this))
+, _timerWheel(std::make_unique<TimerWheel>())
 , _api(std::make_unique<ApiWrap>(this))
 , _updates(std::make_unique<Api::Updates>(this))
 , _sendProgressManager(std::make_unique<Api::SendProgressManager>(this))
@@ -179,19 +182,10 @@ Session::Session(
 
 		// Storage::Account uses Main::Account::session() in those methods.
 		// So they can't be called during Main::Session construction.
-		local().readInstalledStickers();
-		local().readInstalledMasks();
-		local().readInstalledCustomEmoji();
-		local().readFeaturedStickers();
-		local().readFeaturedCustomEmoji();
-		local().readRecentStickers();
-		local().readRecentMasks();
-		local().readFavedStickers();
-		local().readSavedGifs();
-		data().stickers().notifyUpdated(Data::StickersType::Stickers);
-		data().stickers().notifyUpdated(Data::StickersType::Masks);
-		data().stickers().notifyUpdated(Data::StickersType::Emoji);
-		data().stickers().notifySavedGifsUpdated();
+		readCriticalLocalData();
+		local().preloadStickersFiles(crl::guard(this, [=] {
+			readDeferredLocalData();
+		}));
 	});
 
 #ifndef TDESKTOP_DISABLE_SPELLCHECK
@@ -205,6 +199,47 @@ Session::Session(
 	Core::App().downloadManager().trackSession(this);
 }
 
+void Session::readCriticalLocalData() {
+	if (_criticalLocalRead) {
+		return;
+	}
+	_criticalLocalRead = true;
+
+	const auto span = Core::StartupTrace::Span("Session::readLocalStickers");
+	local().readInstalledStickers();
+	local().readInstalledCustomEmoji();
+	local().readRecentStickers();
+	data().stickers().notifyUpdated(Data::StickersType::Stickers);
+	data().stickers().notifyUpdated(Data::StickersType::Emoji);
+}
+
+void Session::readDeferredLocalData() {
+	if (_deferredLocalRead) {
+		return;
+	}
+	_deferredLocalRead = true;
+	readCriticalLocalData();
+
+	const auto span = Core::StartupTrace::Span("Session::readDeferred");
+	local().readInstalledMasks();
+	local().readFeaturedStickers();
+	local().readFeaturedCustomEmoji();
+	local().readRecentMasks();
+	local().readFavedStickers();
+	local().readSavedGifs();
+	data().stickers().notifyUpdated(Data::StickersType::Stickers);
+	data().stickers().notifyUpdated(Data::StickersType::Masks);
+	data().stickers().notifyUpdated(Data::StickersType::Emoji);
+	data().stickers().notifySavedGifsUpdated();
+	local().clearPreloadedFiles();
+}
+
+void Session::markLocalDataRead() {
+	// Nothing should be read from the disk while the data is cleared.
+	_criticalLocalRead = _deferredLocalRead = true;
+	local().clearPreloadedFiles();
+}
+
 void Session::setTmpPassword(const QByteArray &password, TimeId validUntil) {
 	if (_tmpPassword.isEmpty() || validUntil > _tmpPasswordValidUntil) {
 		_tmpPassword = password;
@@ -222,12 +257,14 @@ QByteArray Session::validTmpPassword() const {
 // Can be called only right before ~Session.
 void Session::finishLogout() {
 	unlockTerms();
+	markLocalDataRead();
 	data().clear();
 	data().clearLocalStorage();
 }
 
 Session::~Session() {
 	unlockTerms();
+	markLocalDataRead();
 	data().clear();
 	ClickHandler::clearActive();
 	ClickHandler::unpressed();
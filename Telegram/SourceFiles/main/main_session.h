@@ -78,6 +78,7 @@ class AppConfig;
 class Domain;
 class SessionSettings;
 class SendAsPeers;
+class TimerWheel;
 
 class Session final : public base::has_weak_ptr {
 public:
@@ -115,6 +116,9 @@ public:
 	[[nodiscard]] Data::Changes &changes() const {
 		return *_changes;
 	}
+	[[nodiscard]] TimerWheel &timerWheel() const {
+		return *_timerWheel;
+	}
 	[[nodiscard]] Data::RecentPeers &recentPeers() const {
 		return *_recentPeers;
 	}
@@ -215,6 +219,10 @@ public:
 	[[nodiscard]] TextWithEntities createInternalLinkFull(
 		TextWithEntities query) const;
 
+	// Sticker sets that the chats list doesn't need are read from the
+	// local storage on a background thread, or right before they're used.
+	void readDeferredLocalData();
+
 	void setTmpPassword(const QByteArray &password, TimeId validUntil);
 	[[nodiscard]] QByteArray validTmpPassword() const;
 
@@ -240,11 +248,15 @@ public:
 private:
 	static constexpr auto kDefaultSaveDelay = crl::time(1000);
 
+	void readCriticalLocalData();
+	void markLocalDataRead();
+
 	const UserId _userId;
 	const not_null<Account*> _account;
 
 	const std::unique_ptr<SessionSettings> _settings;
 	const std::unique_ptr<Data::Changes> _changes;
+	const std::unique_ptr<TimerWheel> _timerWheel;
 	const std::unique_ptr<ApiWrap> _api;
 	const std::unique_ptr<Api::Updates> _updates;
 	const std::unique_ptr<Api::SendProgressManager> _sendProgressManager;
@@ -284,6 +296,8 @@ private:
 
 	base::flat_set<not_null<Window::SessionController*>> _windows;
 	base::Timer _saveSettingsTimer;
+	bool _criticalLocalRead = false;
+	bool _deferredLocalRead = false;
 
 	QByteArray _tmpPassword;
 	TimeId _tmpPasswordValidUntil = 0;
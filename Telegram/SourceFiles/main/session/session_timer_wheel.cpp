@@ -0,0 +1,113 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "main/session/session_timer_wheel.h"
+
+namespace Main {
+namespace {
+
+struct WheelLevel {
+	crl::time till = 0;
+	crl::time tick = 0;
+};
+
+// Deadlines in less than a minute are fired with a second precision,
+// in less than an hour - with a five seconds precision, further ones
+// are aligned to whole minutes.
+constexpr auto kLevels = std::array{
+	WheelLevel{ 60 * crl::time(1000), crl::time(1000) },
+	WheelLevel{ 3600 * crl::time(1000), 5 * crl::time(1000) },
+	WheelLevel{ std::numeric_limits<crl::time>::max(), 60 * crl::time(1000) },
+};
+
+} // namespace
+
+TimerWheel::TimerWheel()
+: _timer([=] { check(); }) {
+}
+
+crl::time TimerWheel::Round(crl::time timeout, crl::time now) {
+	const auto when = now + std::max(timeout, crl::time(1));
+	for (const auto &level : kLevels) {
+		if (timeout < level.till) {
+			return ((when + level.tick - 1) / level.tick) * level.tick;
+		}
+	}
+	Unexpected("Level in TimerWheel::Round.");
+}
+
+rpl::producer<> TimerWheel::after(crl::time timeout) {
+	const auto when = Round(timeout, crl::now());
+	const auto weak = base::make_weak(this);
+	return rpl::make_producer<>([=](auto consumer) {
+		const auto strong = weak.get();
+		if (!strong) {
+			return rpl::lifetime();
+		}
+		auto &slot = strong->_slots[when];
+		++slot.consumers;
+		auto subscription = (slot.stream.events()
+			| rpl::take(1)).start_existing(consumer);
+		strong->schedule();
+
+		// Detach the consumer before the slot with its stream may go.
+		return rpl::lifetime([=, subscription = std::move(subscription)](
+		) mutable {
+			subscription.destroy();
+			if (const auto strong = weak.get()) {
+				strong->release(when);
+			}
+		});
+	});
+}
+
+void TimerWheel::release(crl::time when) {
+	// Fired slots are already taken out of the wheel.
+	const auto i = _slots.find(when);
+	if (i == end(_slots) || --i->second.consumers > 0) {
+		return;
+	}
+	_slots.erase(i);
+	schedule();
+}
+
+void TimerWheel::check() {
+	const auto now = crl::now();
+	_scheduled = 0;
+	if (_slots.empty() || _slots.begin()->first > now) {
+		schedule();
+		return;
+	}
+	auto ready = std::vector<rpl::event_stream<>>();
+	while (!_slots.empty() && _slots.begin()->first <= now) {
+		ready.push_back(std::move(_slots.begin()->second.stream));
+		_slots.erase(_slots.begin());
+	}
+
+	// Firing may add new deadlines, so the fired slots are taken out
+	// of the wheel before that.
+	for (auto &slot : ready) {
+		slot.fire({});
+	}
+	schedule();
+}
+
+void TimerWheel::schedule() {
+	if (_slots.empty()) {
+		_timer.cancel();
+		_scheduled = 0;
+		return;
+	}
+	const auto when = _slots.begin()->first;
+	if (_scheduled == when && _timer.isActive()) {
+		return;
+	}
+	_scheduled = when;
+	_timer.callOnce(std::max(when - crl::now(), crl::time(0)));
+}
+
+} // namespace Main
@@ -0,0 +1,45 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "base/timer.h"
+#include "base/weak_ptr.h"
+
+namespace Main {
+
+// Shared deadlines for things like online status or "last seen" texts.
+//
+// Deadlines are rounded up to a tick, which gets coarser the further
+// away the deadline is, so that many of them share a single wakeup.
+class TimerWheel final : public base::has_weak_ptr {
+public:
+	TimerWheel();
+
+	// Fires once, not earlier than in 'timeout' ms from now.
+	// The deadline is dropped when its last subscription is destroyed.
+	[[nodiscard]] rpl::producer<> after(crl::time timeout);
+
+private:
+	struct Slot {
+		rpl::event_stream<> stream;
+		int consumers = 0;
+	};
+
+	[[nodiscard]] static crl::time Round(crl::time timeout, crl::time now);
+
+	void release(crl::time when);
+	void check();
+	void schedule();
+
+	std::map<crl::time, Slot> _slots;
+	base::Timer _timer;
+	crl::time _scheduled = 0;
+
+};
+
+} // namespace Main
@@ -12,6 +12,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 #include "base/random.h"
 #include "base/qthelp_url.h"
+#include "base/invoke_queued.h"
 
 namespace MTP {
 namespace details {
@@ -21,7 +22,7 @@ constexpr auto kPacketSizeMax = int(0x01000000 * sizeof(mtpPrime));
 constexpr auto kFullConnectionTimeout = 8 * crl::time(1000);
 constexpr auto kSmallBufferSize = 256 * 1024;
 constexpr auto kMinPacketBuffer = 256;
-constexpr auto kConnectionStartPrefixSize = 64;
+constexpr auto kCoalesceBytesMax = 64 * 1024;
 
 } // namespace
 
@@ -431,16 +432,78 @@ void TcpConnection::sendData(mtpBuffer &&buffer) {
 	if (!_socket) {
 		return;
 	}
-	char connectionStartPrefixBytes[kConnectionStartPrefixSize];
-	const auto connectionStartPrefix = prepareConnectionStartPrefix(
-		bytes::make_span(connectionStartPrefixBytes));
 
 	// buffer: 2 available int-s + data + available int.
 	const auto bytes = _protocol->finalizePacket(buffer);
 	CONNECTION_LOG_INFO(u"TCP Info: write packet %1 bytes."_q
 		.arg(bytes.size()));
+
+	if (bytes.size() >= kCoalesceBytesMax) {
+		// Large packets, like upload parts, are not worth copying.
+		flushPendingWrite();
+		const auto prefix = prepareConnectionStartPrefix(
+			bytes::make_span(_pendingPrefix));
+		aesCtrEncrypt(bytes, _sendKey, &_sendState);
+		writeToSocket(prefix, bytes, 1);
+		return;
+	} else if (_pendingWrite.empty()) {
+		const auto prefix = prepareConnectionStartPrefix(
+			bytes::make_span(_pendingPrefix));
+		_pendingPrefixSize = int(prefix.size());
+	}
+
+	// Packets are encrypted right away to keep the CTR stream in order,
+	// but written to the socket together once the current batch of
+	// sends from the session is over.
 	aesCtrEncrypt(bytes, _sendKey, &_sendState);
-	_socket->write(connectionStartPrefix, bytes);
+	const auto wasEmpty = _pendingWrite.empty();
+	_pendingWrite.insert(_pendingWrite.end(), bytes.begin(), bytes.end());
+	++_pendingPackets;
+	if (_pendingWrite.size() >= kCoalesceBytesMax) {
+		flushPendingWrite();
+	} else if (wasEmpty) {
+		InvokeQueued(this, [=] { flushPendingWrite(); });
+	}
+}
+
+void TcpConnection::flushPendingWrite() {
+	if (_pendingWrite.empty()) {
+		return;
+	} else if (!_socket) {
+		_pendingWrite.clear();
+		_pendingPackets = 0;
+		return;
+	}
+	const auto prefix = bytes::make_span(_pendingPrefix).subspan(
+		0,
+		_pendingPrefixSize);
+	writeToSocket(prefix, _pendingWrite, _pendingPackets);
+
+	_pendingWrite.clear();
+	_pendingPackets = 0;
+	_pendingPrefixSize = 0;
+}
+
+void TcpConnection::writeToSocket(
+		bytes::const_span prefix,
+		bytes::const_span buffer,
+		int packets) {
+	Expects(_socket != nullptr);
+
+	_socket->write(prefix, buffer);
+
+	const auto size = int64(prefix.size()) + int64(buffer.size());
+	++_writesCount;
+	_packetsWritten += packets;
+	_bytesWritten += size;
+	CONNECTION_LOG_INFO(u"TCP Info: "
+		"flushed %1 packets in %2 bytes, "
+		"total %3 writes, %4 packets, %5 bytes per write."_q
+		.arg(packets)
+		.arg(size)
+		.arg(_writesCount)
+		.arg(_packetsWritten)
+		.arg(_bytesWritten / _writesCount));
 }
 
 bytes::const_span TcpConnection::prepareConnectionStartPrefix(
@@ -501,6 +564,8 @@ void TcpConnection::disconnectFromServer() {
 	_connectedLifetime.destroy();
 	_lifetime.destroy();
 	_socket = nullptr;
+	_pendingWrite.clear();
+	_pendingPackets = 0;
 }
 
 void TcpConnection::connectToServer(
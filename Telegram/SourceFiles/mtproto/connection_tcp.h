@@ -53,6 +53,11 @@ private:
 
 	void socketRead();
 	bytes::const_span prepareConnectionStartPrefix(bytes::span buffer);
+	void flushPendingWrite();
+	void writeToSocket(
+		bytes::const_span prefix,
+		bytes::const_span buffer,
+		int packets);
 
 	void socketPacket(bytes::const_span bytes);
 
@@ -71,6 +76,15 @@ private:
 	std::unique_ptr<AbstractSocket> _socket;
 	bool _connectionStarted = false;
 
+	static constexpr auto kStartPrefixSize = 64;
+	bytes::type _pendingPrefix[kStartPrefixSize];
+	int _pendingPrefixSize = 0;
+	bytes::vector _pendingWrite;
+	int _pendingPackets = 0;
+	int _writesCount = 0;
+	int64 _packetsWritten = 0;
+	int64 _bytesWritten = 0;
+
 	int _offsetBytes = 0;
 	int _readBytes = 0;
 	int _leftBytes = 0;
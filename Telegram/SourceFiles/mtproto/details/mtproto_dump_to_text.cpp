@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "mtproto/details/mtproto_dump_to_text.h"
 
+#include "scheme-dispatch.h"
 #include "scheme-dump_to_text.h"
 #include "scheme.h"
 
@@ -14,6 +15,13 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace MTP::details {
 
+QString TypeName(mtpTypeId type) {
+	if (const auto constructor = dispatch::Find(type)) {
+		return QString::fromLatin1(constructor->name);
+	}
+	return u"0x%1"_q.arg(type, 8, 16, QChar('0'));
+}
+
 bool DumpToTextCore(DumpToTextBuffer &to, const mtpPrime *&from, const mtpPrime *end, mtpTypeId cons, uint32 level, mtpPrime vcons) {
 	switch (mtpTypeId(cons)) {
 	case mtpc_int: {
@@ -15,6 +15,9 @@ namespace MTP::details {
 // Human-readable text serialization
 QString DumpToText(const mtpPrime *&from, const mtpPrime *end);
 
+// Constructor name from the scheme or the hex type id if it is unknown.
+[[nodiscard]] QString TypeName(mtpTypeId type);
+
 struct DumpToTextBuffer {
 	static constexpr auto kBufferSize = 1024 * 1024; // 1 mb start size
 
@@ -7,6 +7,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 */
 #include "mtproto/mtproto_dc_options.h"
 
+#include "mtproto/details/mtproto_dump_to_text.h"
 #include "mtproto/details/mtproto_rsa_public_key.h"
 #include "mtproto/facade.h"
 #include "mtproto/connection_tcp.h"
@@ -211,7 +212,8 @@ void DcOptions::processFromList(
 	}();
 	for (auto &mtpOption : options) {
 		if (mtpOption.type() != mtpc_dcOption) {
-			LOG(("Wrong type in DcOptions: %1").arg(mtpOption.type()));
+			LOG(("Wrong type in DcOptions: %1"
+				).arg(details::TypeName(mtpOption.type())));
 			continue;
 		}
 
@@ -20,6 +20,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "base/openssl_help.h"
 #include "base/unixtime.h"
 #include "base/platform/base_platform_info.h"
+#include "scheme-dispatch.h"
 
 #include <ksandbox.h>
 #include <zlib.h>
@@ -1443,6 +1444,17 @@ SessionPrivate::HandleResult SessionPrivate::handleOneReceived(
 		OuterInfo info) {
 	Expects(from < end);
 
+	// Truncated objects are dropped before the constructor specific code.
+	if (const auto constructor = dispatch::Find(mtpTypeId(*from))) {
+		if (end - from - 1 < ptrdiff_t(constructor->minimalLength)) {
+			LOG(("Message Error: %1 of %2 primes is shorter than %3."
+				).arg(QString::fromLatin1(constructor->name)
+				).arg(end - from - 1
+				).arg(constructor->minimalLength));
+			return HandleResult::ParseError;
+		}
+	}
+
 	switch (mtpTypeId(*from)) {
 
 	case mtpc_gzip_packed: {
@@ -2011,12 +2023,24 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 	mtpBuffer result; // * 4 because of mtpPrime type
 	result.resize(0);
 
-	MTPstring packed;
-	if (!packed.read(from, end)) { // read packed string as serialized mtp string type
+	// Inflate right from the serialized mtp string bytes,
+	// without copying them to a separate MTPstring first.
+	const auto available = uint32(end - from) * sizeof(mtpPrime);
+	const auto bytes = reinterpret_cast<const uchar*>(from);
+	const auto shortLength = available ? uint32(bytes[0]) : 0U;
+	const auto headerLen = (shortLength < 254) ? 1U : 4U;
+	const auto packedLen = (shortLength < 254)
+		? shortLength
+		: (available >= 4)
+		? (uint32(bytes[1])
+			| (uint32(bytes[2]) << 8)
+			| (uint32(bytes[3]) << 16))
+		: 0U;
+	if (!available || headerLen + packedLen > available) {
 		LOG(("RPC Error: could not read gziped bytes."));
 		return result;
 	}
-	uint32 packedLen = packed.v.size(), unpackedChunk = packedLen;
+	const auto packed = bytes + headerLen;
 
 	z_stream stream;
 	stream.zalloc = 0;
@@ -2030,8 +2054,11 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 		return result;
 	}
 	stream.avail_in = packedLen;
-	stream.next_in = reinterpret_cast<Bytef*>(packed.v.data());
+	stream.next_in = const_cast<Bytef*>(packed);
 
+	// Grow the result geometrically, so that highly compressed responses
+	// don't get reallocated for each next chunk of the packed size.
+	auto unpackedChunk = std::max(packedLen, 256U);
 	stream.avail_out = 0;
 	while (!stream.avail_out) {
 		result.resize(result.size() + unpackedChunk);
@@ -2041,9 +2068,10 @@ mtpBuffer SessionPrivate::ungzip(const mtpPrime *from, const mtpPrime *end) cons
 		if (res != Z_OK && res != Z_STREAM_END) {
 			inflateEnd(&stream);
 			LOG(("RPC Error: could not unpack gziped data, code: %1").arg(res));
-			DEBUG_LOG(("RPC Error: bad gzip: %1").arg(Logs::mb(packed.v.constData(), packedLen).str()));
+			DEBUG_LOG(("RPC Error: bad gzip: %1").arg(Logs::mb(packed, packedLen).str()));
 			return mtpBuffer();
 		}
+		unpackedChunk = uint32(result.size());
 	}
 	if (stream.avail_out & 0x03) {
 		uint32 badSize = result.size() * sizeof(mtpPrime) - stream.avail_out;
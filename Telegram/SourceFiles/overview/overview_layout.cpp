@@ -470,6 +470,12 @@ void Photo::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Photo::preloadHeavyPart() {
+	if (!_goodLoaded) {
+		ensureDataMediaCreated();
+	}
+}
+
 TextState Photo::getState(
 		QPoint point,
 		StateRequest request) const {
@@ -655,6 +661,12 @@ void Video::clearHeavyPart() {
 	_dataMedia = nullptr;
 }
 
+void Video::preloadHeavyPart() {
+	if (_pixBlurred) {
+		ensureDataMediaCreated();
+	}
+}
+
 float64 Video::dataProgress() const {
 	ensureDataMediaCreated();
 	return _dataMedia->progress();
@@ -75,6 +75,8 @@ public:
 	}
 	virtual void clearHeavyPart() {
 	}
+	virtual void preloadHeavyPart() {
+	}
 
 protected:
 	[[nodiscard]] not_null<HistoryItem*> parent() const {
@@ -209,6 +211,7 @@ public:
 
 	void itemDataChanged() override;
 	void clearHeavyPart() override;
+	void preloadHeavyPart() override;
 
 private:
 	void ensureDataMediaCreated() const;
@@ -303,6 +306,7 @@ public:
 
 	void itemDataChanged() override;
 	void clearHeavyPart() override;
+	void preloadHeavyPart() override;
 	void clearSpoiler() override;
 
 protected:
@@ -43,6 +43,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "main/main_account.h"
 #include "main/main_session.h"
 #include "main/main_domain.h"
+#include "main/session/session_timer_wheel.h"
 #include "mtproto/mtproto_dc_options.h"
 #include "window/window_session_controller.h"
 #include "window/window_controller.h"
@@ -218,19 +219,25 @@ private:
 		not_null<UserData*> user) {
 	return [=](auto consumer) {
 		auto lifetime = rpl::lifetime();
-		const auto timer = lifetime.make_state<base::Timer>();
-		const auto push = [=] {
+		const auto refresh = lifetime.make_state<rpl::lifetime>();
+		const auto push = lifetime.make_state<Fn<void()>>();
+		*push = [=] {
 			const auto now = base::unixtime::now();
 			consumer.put_next(Data::OnlineTextActive(user, now)
 				? Ui::Text::Link(Data::OnlineText(user, now))
 				: Ui::Text::WithEntities(Data::OnlineText(user, now)));
-			timer->callOnce(Data::OnlineChangeTimeout(user, now));
+			*refresh = user->session().timerWheel().after(
+				Data::OnlineChangeTimeout(user, now)
+			) | rpl::start_with_next([=] {
+				(*push)();
+			});
 		};
-		timer->setCallback(push);
 		user->session().changes().peerFlagsValue(
 			user,
 			Data::PeerUpdate::Flag::OnlineStatus
-		) | rpl::start_with_next(push, lifetime);
+		) | rpl::start_with_next([=] {
+			(*push)();
+		}, lifetime);
 		return lifetime;
 	};
 }
@@ -0,0 +1,107 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "statistics/chart_points_pyramid.h"
+
+namespace Statistic {
+namespace {
+
+constexpr auto kMinPointsCount = 512;
+
+} // namespace
+
+PointsPyramid::PointsPyramid(const std::vector<ChartValue> &y) {
+	const auto n = int(y.size());
+	if (n < kMinPointsCount) {
+		return;
+	}
+	const auto pick = [&](int a, int b, bool max) {
+		if (a < 0 || b < 0) {
+			return std::max(a, b);
+		}
+		return (max ? (y[b] > y[a]) : (y[b] < y[a])) ? b : a;
+	};
+
+	auto first = std::vector<Bucket>((n + 1) / 2);
+	for (auto i = 0; i < n; i += 2) {
+		const auto a = (y[i] < 0) ? -1 : i;
+		const auto b = (i + 1 < n && y[i + 1] >= 0) ? (i + 1) : -1;
+		first[i / 2] = { .min = pick(a, b, false), .max = pick(a, b, true) };
+	}
+	_levels.push_back(std::move(first));
+
+	while (_levels.back().size() > 1) {
+		const auto &previous = _levels.back();
+		const auto size = int(previous.size());
+		auto next = std::vector<Bucket>((size + 1) / 2);
+		for (auto i = 0; i < size; i += 2) {
+			const auto &a = previous[i];
+			const auto &b = (i + 1 < size) ? previous[i + 1] : Bucket();
+			next[i / 2] = {
+				.min = pick(a.min, b.min, false),
+				.max = pick(a.max, b.max, true),
+			};
+		}
+		_levels.push_back(std::move(next));
+	}
+}
+
+void PointsPyramid::collect(
+		const std::vector<ChartValue> &y,
+		int from,
+		int to,
+		int columns,
+		std::vector<int> &indices) const {
+	indices.clear();
+	if (from > to) {
+		return;
+	}
+	const auto count = to - from + 1;
+	auto level = -1;
+	while ((level + 1 < int(_levels.size()))
+		&& ((count >> (level + 2)) >= columns)) {
+		++level;
+	}
+	if (level < 0) {
+		indices.reserve(count);
+		for (auto i = from; i <= to; i++) {
+			if (y[i] >= 0) {
+				indices.push_back(i);
+			}
+		}
+		return;
+	}
+
+	// The first and the last points are kept so that the line
+	// reaches the edges of the range.
+	const auto &buckets = _levels[level];
+	const auto shift = level + 1;
+	const auto push = [&](int index) {
+		if (index >= from
+			&& index <= to
+			&& (indices.empty() || indices.back() < index)) {
+			indices.push_back(index);
+		}
+	};
+	indices.reserve(2 * ((count >> shift) + 2) + 2);
+	if (y[from] >= 0) {
+		indices.push_back(from);
+	}
+	for (auto i = (from >> shift); i <= (to >> shift); i++) {
+		const auto &bucket = buckets[i];
+		if (bucket.min < 0) {
+			continue;
+		}
+		push(std::min(bucket.min, bucket.max));
+		push(std::max(bucket.min, bucket.max));
+	}
+	if (y[to] >= 0) {
+		push(to);
+	}
+}
+
+} // namespace Statistic
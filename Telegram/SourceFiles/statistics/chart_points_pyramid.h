@@ -0,0 +1,47 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "statistics/statistics_types.h"
+
+namespace Statistic {
+
+// Min / max buckets of a chart line on power-of-two levels, so that
+// a range can be painted with about two points per pixel column
+// regardless of the amount of the points in it.
+class PointsPyramid final {
+public:
+	PointsPyramid() = default;
+	PointsPyramid(const std::vector<ChartValue> &y);
+
+	[[nodiscard]] bool empty() const {
+		return _levels.empty();
+	}
+
+	// Fills the indices of the points in [from, to] worth painting
+	// in the given amount of columns, in the ascending order.
+	// Negative values are skipped as missing points.
+	void collect(
+		const std::vector<ChartValue> &y,
+		int from,
+		int to,
+		int columns,
+		std::vector<int> &indices) const;
+
+private:
+	struct Bucket final {
+		int min = -1;
+		int max = -1;
+	};
+
+	// _levels[k] holds the buckets of 2 ^ (k + 1) points.
+	std::vector<std::vector<Bucket>> _levels;
+
+};
+
+} // namespace Statistic
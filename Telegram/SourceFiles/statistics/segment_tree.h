@@ -11,60 +11,28 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 
 namespace Statistic {
 
+// Bottom-up min / max tree over a flat array: leaves are stored
+// at [n, 2n) and the parent of the node i is i / 2.
 class SegmentTree final {
 public:
 	SegmentTree() = default;
 	SegmentTree(std::vector<ChartValue> array);
 
 	[[nodiscard]] bool empty() const {
-		return _array.empty();
+		return !_size;
 	}
 	[[nodiscard]] explicit operator bool() const {
 		return !empty();
 	}
 
-	[[nodiscard]] ChartValue rMaxQ(int from, int to);
-	[[nodiscard]] ChartValue rMinQ(int from, int to);
+	// The result is never less than zero, like for an empty range.
+	[[nodiscard]] ChartValue rMaxQ(int from, int to) const;
+	[[nodiscard]] ChartValue rMinQ(int from, int to) const;
 
 private:
-	struct Node final {
-		ChartValue sum = 0;
-		ChartValue max = 0;
-		ChartValue min = 0;
-
-		struct PendingVal {
-			[[nodiscard]] explicit operator bool() const {
-				return available;
-			}
-			ChartValue value = 0;
-			bool available = false;
-		};
-		PendingVal pendingVal;
-
-		int from = 0;
-		int to = 0;
-
-		[[nodiscard]] int size() {
-			return to - from + 1;
-		}
-	};
-
-	void build(ChartValue v, int from, int size);
-	void propagate(ChartValue v);
-	void change(Node &n, ChartValue value);
-
-	[[nodiscard]] ChartValue rMaxQ(ChartValue v, int from, int to);
-	[[nodiscard]] ChartValue rMinQ(ChartValue v, int from, int to);
-
-	[[nodiscard]] bool contains(int from1, int to1, int from2, int to2) const;
-	[[nodiscard]] bool intersects(
-		int from1,
-		int to1,
-		int from2,
-		int to2) const;
-
-	std::vector<ChartValue> _array;
-	std::vector<Node> _heap;
+	int _size = 0;
+	std::vector<ChartValue> _max;
+	std::vector<ChartValue> _min;
 
 };
 
@@ -18,72 +18,229 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <QtCore/QJsonObject>
 #include <QtCore/QJsonValue>
 
+#include <charconv>
+
 namespace Statistic {
+namespace {
 
-Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
-	auto error = QJsonParseError{ 0, QJsonParseError::NoError };
-	const auto document = QJsonDocument::fromJson(json, &error);
-	if (error.error != QJsonParseError::NoError || !document.isObject()) {
-		LOG(("API Error: Bad stats graph json received."));
-		return {};
+// Reads the graph json without building a QJsonDocument for the columns,
+// which take almost all of its size. Other values are small and are
+// parsed separately from their raw bytes.
+class Reader final {
+public:
+	explicit Reader(const QByteArray &json)
+	: _data(json.constData())
+	, _end(json.constData() + json.size()) {
 	}
-	const auto root = document.object();
-	const auto columns = root.value(u"columns"_q).toArray();
-	if (columns.empty()) {
-		LOG(("API Error: Empty columns list from stats graph received."));
-		return {};
+
+	[[nodiscard]] bool failed() const {
+		return _failed;
 	}
 
-	const auto hiddenLinesRaw = root.value(u"hidden"_q).toArray();
-	const auto hiddenLines = ranges::views::all(
-		hiddenLinesRaw
-	) | ranges::views::transform([](const auto &q) {
-		return q.toString();
-	}) | ranges::to_vector;
+	[[nodiscard]] bool consume(char c);
+	[[nodiscard]] QString readString();
+	[[nodiscard]] double readNumber();
+	[[nodiscard]] QByteArray readRawValue();
 
-	auto result = Data::StatisticalChart();
+	// Amount of the values left in the current array of numbers.
+	[[nodiscard]] int countNumbersLeft() const;
 
-	{
-		const auto tickFormatIt = root.constFind(u"yTickFormatter"_q);
-		if (tickFormatIt != root.constEnd()) {
-			const auto tickFormat = tickFormatIt->toString();
-			if (tickFormat.contains(u"TON"_q)) {
-				result.currency = Data::StatisticalCurrency::Ton;
-			} else if (tickFormat.contains(Ui::kCreditsCurrency)) {
-				result.currency = Data::StatisticalCurrency::Credits;
+private:
+	void skipSpaces();
+	void skipString();
+	void fail();
+
+	const char *_data = nullptr;
+	const char *_end = nullptr;
+	bool _failed = false;
+
+};
+
+bool Reader::consume(char c) {
+	skipSpaces();
+	if (_data != _end && *_data == c) {
+		++_data;
+		return true;
+	}
+	return false;
+}
+
+QString Reader::readString() {
+	skipSpaces();
+	const auto start = _data;
+	skipString();
+	if (_failed) {
+		return QString();
+	}
+	const auto raw = QByteArray::fromRawData(
+		start + 1,
+		int(_data - start - 2));
+	if (!raw.contains('\\')) {
+		return QString::fromUtf8(raw);
+	}
+	const auto wrapped = '[' + QByteArray(start, int(_data - start)) + ']';
+	return QJsonDocument::fromJson(wrapped).array().first().toString();
+}
+
+double Reader::readNumber() {
+	skipSpaces();
+	const auto start = _data;
+	auto integer = true;
+	while (_data != _end) {
+		const auto c = *_data;
+		if (c == '.' || c == 'e' || c == 'E') {
+			integer = false;
+		} else if ((c < '0' || c > '9') && c != '-' && c != '+') {
+			break;
+		}
+		++_data;
+	}
+	if (_data == start) {
+		if (_end - _data >= 4 && !memcmp(_data, "null", 4)) {
+			_data += 4;
+			return 0.;
+		}
+		fail();
+		return 0.;
+	} else if (integer) {
+		auto value = int64();
+		const auto result = std::from_chars(start, _data, value);
+		if (result.ec == std::errc() && result.ptr == _data) {
+			return double(value);
+		}
+	}
+	auto ok = false;
+	const auto value = QByteArray::fromRawData(
+		start,
+		int(_data - start)).toDouble(&ok);
+	if (!ok) {
+		fail();
+	}
+	return value;
+}
+
+QByteArray Reader::readRawValue() {
+	skipSpaces();
+	const auto start = _data;
+	auto depth = 0;
+	while (_data != _end && !_failed) {
+		const auto c = *_data;
+		if (c == '"') {
+			skipString();
+		} else if (c == '{' || c == '[') {
+			++depth;
+			++_data;
+		} else if (c == '}' || c == ']') {
+			if (!depth) {
+				break;
+			}
+			--depth;
+			++_data;
+		} else if (c == ',' && !depth) {
+			break;
+		} else {
+			++_data;
+		}
+		if (!depth) {
+			const auto next = std::find_if(_data, _end, [](char ch) {
+				return (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r');
+			});
+			if (next != _end
+				&& (*next == ',' || *next == '}' || *next == ']')) {
+				break;
 			}
 		}
 	}
+	if (_failed || depth || _data == start) {
+		fail();
+		return QByteArray();
+	}
+	return QByteArray(start, int(_data - start));
+}
+
+int Reader::countNumbersLeft() const {
+	const auto till = std::find(_data, _end, ']');
+	return int(std::count(_data, till, ','));
+}
+
+void Reader::skipSpaces() {
+	while (_data != _end
+		&& (*_data == ' '
+			|| *_data == '\t'
+			|| *_data == '\n'
+			|| *_data == '\r')) {
+		++_data;
+	}
+}
+
+void Reader::skipString() {
+	if (_data == _end || *_data != '"') {
+		fail();
+		return;
+	}
+	for (++_data; _data != _end; ++_data) {
+		if (*_data == '\\') {
+			if (++_data == _end) {
+				break;
+			}
+		} else if (*_data == '"') {
+			++_data;
+			return;
+		}
+	}
+	fail();
+}
+
+void Reader::fail() {
+	_failed = true;
+	_data = _end;
+}
+
+[[nodiscard]] QJsonValue ParseValue(const QByteArray &raw) {
+	const auto document = QJsonDocument::fromJson('[' + raw + ']');
+	return document.isArray()
+		? document.array().first()
+		: QJsonValue(QJsonValue::Undefined);
+}
+
+enum class ColumnsResult {
+	Success,
+	BadJson,
+	EmptyColumns,
+	EmptyColumn,
+};
+
+[[nodiscard]] ColumnsResult ReadColumns(
+		Reader &reader,
+		Data::StatisticalChart &result) {
+	if (!reader.consume('[')) {
+		return ColumnsResult::BadJson;
+	} else if (reader.consume(']')) {
+		return ColumnsResult::EmptyColumns;
+	}
 	auto columnIdCount = 0;
-	for (const auto &column : columns) {
-		const auto array = column.toArray();
-		if (array.empty()) {
-			LOG(("API Error: Empty column from stats graph received."));
-			return {};
+	do {
+		if (!reader.consume('[')) {
+			return ColumnsResult::BadJson;
+		} else if (reader.consume(']')) {
+			return ColumnsResult::EmptyColumn;
 		}
-		const auto columnId = array.first().toString();
+		const auto columnId = reader.readString();
 		if (columnId == u"x"_q) {
-			const auto length = array.size() - 1;
-			result.x.resize(length);
-			for (auto i = 0; i < length; i++) {
-				result.x[i] = array.at(i + 1).toDouble();
+			result.x.clear();
+			result.x.reserve(reader.countNumbersLeft());
+			while (reader.consume(',')) {
+				result.x.push_back(reader.readNumber());
 			}
 		} else {
 			auto line = Data::StatisticalChart::Line();
-			const auto length = array.size() - 1;
 			line.id = (++columnIdCount);
 			line.idString = columnId;
-			line.isHiddenOnStart = ranges::contains(hiddenLines, columnId);
-			line.y.resize(length);
-			for (auto i = 0; i < length; i++) {
-				using Currency = Data::StatisticalCurrency;
-				const auto multiplier = (result.currency == Currency::Credits)
-					? Data::kEarnMultiplier
-					: 1;
+			line.y.reserve(reader.countNumbersLeft());
+			while (reader.consume(',')) {
 				const auto value = ChartValue(
-						base::SafeRound(array.at(i + 1).toDouble()))
-					* multiplier;
-				line.y[i] = value;
+					base::SafeRound(reader.readNumber()));
+				line.y.push_back(value);
 				if (value > line.maxValue) {
 					line.maxValue = value;
 				}
@@ -93,14 +250,95 @@ Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
 			}
 			result.lines.push_back(std::move(line));
 		}
-		if (result.x.size() > 1) {
-			result.timeStep = result.x[1] - result.x[0];
-		} else {
-			constexpr auto kOneDay = 3600 * 24 * 1000;
-			result.timeStep = kOneDay;
+		if (!reader.consume(']') || reader.failed()) {
+			return ColumnsResult::BadJson;
+		}
+	} while (reader.consume(','));
+	return reader.consume(']')
+		? ColumnsResult::Success
+		: ColumnsResult::BadJson;
+}
+
+} // namespace
+
+Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
+	const auto started = crl::now();
+	auto result = Data::StatisticalChart();
+	auto fields = base::flat_map<QString, QJsonValue>();
+	auto reader = Reader(json);
+	auto columns = ColumnsResult::BadJson;
+	if (reader.consume('{')) {
+		columns = ColumnsResult::EmptyColumns;
+	}
+	if (columns == ColumnsResult::EmptyColumns && !reader.consume('}')) {
+		do {
+			const auto key = reader.readString();
+			if (!reader.consume(':')) {
+				columns = ColumnsResult::BadJson;
+				break;
+			} else if (key == u"columns"_q) {
+				columns = ReadColumns(reader, result);
+				if (columns != ColumnsResult::Success) {
+					break;
+				}
+			} else {
+				fields[key] = ParseValue(reader.readRawValue());
+			}
+		} while (reader.consume(','));
+		if (columns == ColumnsResult::Success && !reader.consume('}')) {
+			columns = ColumnsResult::BadJson;
+		}
+	}
+	if (reader.failed() || columns == ColumnsResult::BadJson) {
+		LOG(("API Error: Bad stats graph json received."));
+		return {};
+	} else if (columns == ColumnsResult::EmptyColumns) {
+		LOG(("API Error: Empty columns list from stats graph received."));
+		return {};
+	} else if (columns == ColumnsResult::EmptyColumn) {
+		LOG(("API Error: Empty column from stats graph received."));
+		return {};
+	}
+	const auto field = [&](const QString &key) {
+		const auto i = fields.find(key);
+		return (i != end(fields))
+			? i->second
+			: QJsonValue(QJsonValue::Undefined);
+	};
+
+	const auto hiddenLinesRaw = field(u"hidden"_q).toArray();
+	const auto hiddenLines = ranges::views::all(
+		hiddenLinesRaw
+	) | ranges::views::transform([](const auto &q) {
+		return q.toString();
+	}) | ranges::to_vector;
+
+	{
+		const auto tickFormat = field(u"yTickFormatter"_q).toString();
+		if (tickFormat.contains(u"TON"_q)) {
+			result.currency = Data::StatisticalCurrency::Ton;
+		} else if (tickFormat.contains(Ui::kCreditsCurrency)) {
+			result.currency = Data::StatisticalCurrency::Credits;
 		}
-		result.measure();
 	}
+	for (auto &line : result.lines) {
+		line.isHiddenOnStart = ranges::contains(hiddenLines, line.idString);
+		if (result.currency == Data::StatisticalCurrency::Credits
+			&& !line.y.empty()) {
+			for (auto &value : line.y) {
+				value *= Data::kEarnMultiplier;
+			}
+			line.maxValue *= Data::kEarnMultiplier;
+			line.minValue *= Data::kEarnMultiplier;
+		}
+	}
+	if (result.x.size() > 1) {
+		result.timeStep = result.x[1] - result.x[0];
+	} else {
+		constexpr auto kOneDay = 3600 * 24 * 1000;
+		result.timeStep = kOneDay;
+	}
+	result.measure();
 	if (result.maxValue == result.minValue) {
 		if (result.minValue) {
 			result.minValue = 0;
@@ -110,7 +348,7 @@ Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
 	}
 
 	{
-		const auto subchart = root.value(u"subchart"_q).toObject();
+		const auto subchart = field(u"subchart"_q).toObject();
 		const auto subchartShowIt = subchart.constFind(u"show"_q);
 		if (subchartShowIt != subchart.constEnd()) {
 			if (subchartShowIt->isBool()) {
@@ -138,24 +376,18 @@ Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
 		result.defaultZoomXIndex.max = std::max(min, max);
 	}
 	{
-
-		const auto percentageShowIt = root.constFind(u"percentage"_q);
-		if (percentageShowIt != root.constEnd()) {
-			if (percentageShowIt->isBool()) {
-				result.hasPercentages = (percentageShowIt->toBool());
-			}
+		const auto percentageShow = field(u"percentage"_q);
+		if (percentageShow.isBool()) {
+			result.hasPercentages = percentageShow.toBool();
 		}
 	}
 	{
-		const auto tooltipFormatIt = root.constFind(u"xTooltipFormatter"_q);
-		if (tooltipFormatIt != root.constEnd()) {
-			const auto tooltipFormat = tooltipFormatIt->toString();
-			result.weekFormat = tooltipFormat.contains(u"'week'"_q);
-		}
+		const auto tooltipFormat = field(u"xTooltipFormatter"_q).toString();
+		result.weekFormat = tooltipFormat.contains(u"'week'"_q);
 	}
 
-	const auto colors = root.value(u"colors"_q).toObject();
-	const auto names = root.value(u"names"_q).toObject();
+	const auto colors = field(u"colors"_q).toObject();
+	const auto names = field(u"names"_q).toObject();
 
 	for (auto &line : result.lines) {
 		const auto colorIt = colors.constFind(line.idString);
@@ -174,6 +406,9 @@ Data::StatisticalChart StatisticalChartFromJSON(const QByteArray &json) {
 		}
 	}
 
+	DEBUG_LOG(("Statistics: Parsed a %1 bytes graph in %2 ms."
+		).arg(json.size()
+		).arg(crl::now() - started));
 	return result;
 }
 
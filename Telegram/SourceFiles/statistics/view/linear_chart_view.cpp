@@ -35,10 +35,26 @@ void PaintChartLine(
 
 	const auto ratio = ratios.ratio(line.id);
 
-	for (auto i = localStart; i <= localEnd; i++) {
-		if (line.y[i] < 0) {
-			continue;
-		}
+	// Visible range as a part of the whole x range, to know how many
+	// pixel columns the points from localStart to localEnd take.
+	const auto visible = (c.xPercentageLimits.max - c.xPercentageLimits.min);
+	const auto covered = c.chartData.xPercentage[localEnd]
+		- c.chartData.xPercentage[localStart];
+	const auto pixels = c.rect.width() * style::DevicePixelRatio();
+	const auto columns = (visible > 0.)
+		? int(base::SafeRound(pixels * covered / visible))
+		: 0;
+
+	auto indices = std::vector<int>();
+	line.pyramid.collect(
+		line.y,
+		localStart,
+		localEnd,
+		std::max(columns, 1),
+		indices);
+	chartPoints.reserve(indices.size());
+
+	for (const auto i : indices) {
 		const auto xPoint = c.rect.width()
 			* ((c.chartData.xPercentage[i] - c.xPercentageLimits.min)
 				/ (c.xPercentageLimits.max - c.xPercentageLimits.min));
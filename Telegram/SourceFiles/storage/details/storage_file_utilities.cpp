@@ -28,10 +28,43 @@ constexpr auto kStrongIterationsCount = 100'000;
 struct WriteEntry {
 	QString basePath;
 	QString base;
+	std::vector<FileWriteDescriptor::Part> parts;
 	QByteArray data;
 	QByteArray md5;
 };
 
+// Encryption and hashing are done on the writer thread,
+// so that the main thread only serializes the data.
+void Prepare(WriteEntry &entry) {
+	auto fullSize = int32(0);
+	auto md5 = HashMd5();
+	auto buffer = QBuffer(&entry.data);
+	const auto opened = buffer.open(QIODevice::WriteOnly);
+	Assert(opened);
+	auto stream = QDataStream(&buffer);
+	for (auto &part : base::take(entry.parts)) {
+		const auto data = part.key
+			? PrepareEncrypted(std::move(part.data), part.key)
+			: std::move(part.data);
+		stream << data;
+		quint32 len = data.isNull() ? 0xffffffff : data.size();
+		if (QSysInfo::ByteOrder != QSysInfo::BigEndian) {
+			len = qbswap(len);
+		}
+		md5.feed(&len, sizeof(len));
+		md5.feed(data.constData(), data.size());
+		fullSize += sizeof(len) + data.size();
+	}
+	stream.setDevice(nullptr);
+	buffer.close();
+
+	md5.feed(&fullSize, sizeof(fullSize));
+	qint32 version = AppVersion;
+	md5.feed(&version, sizeof(version));
+	md5.feed(TdfMagic, TdfMagicLen);
+	entry.md5 = QByteArray((const char*)md5.result(), 0x10);
+}
+
 class WriteManager final {
 public:
 	explicit WriteManager(crl::weak_on_thread<WriteManager> weak);
@@ -95,6 +128,8 @@ void WriteManager::writeSync(WriteEntry &&entry) {
 }
 
 void WriteManager::writeNow(WriteEntry &&entry) {
+	Prepare(entry);
+
 	const auto path = [&](char postfix) {
 		return this->path(entry, postfix);
 	};
@@ -398,50 +433,35 @@ FileWriteDescriptor::~FileWriteDescriptor() {
 
 void FileWriteDescriptor::init(const QString &name) {
 	_base = _basePath + name;
-	_buffer.setBuffer(&_safeData);
-	const auto opened = _buffer.open(QIODevice::WriteOnly);
-	Assert(opened);
-	_stream.setDevice(&_buffer);
 }
 
 void FileWriteDescriptor::writeData(const QByteArray &data) {
-	if (!_stream.device()) {
+	if (_finished) {
 		return;
 	}
-	_stream << data;
-	quint32 len = data.isNull() ? 0xffffffff : data.size();
-	if (QSysInfo::ByteOrder != QSysInfo::BigEndian) {
-		len = qbswap(len);
-	}
-	_md5.feed(&len, sizeof(len));
-	_md5.feed(data.constData(), data.size());
-	_fullSize += sizeof(len) + data.size();
+	_parts.push_back({ .data = data });
 }
 
 void FileWriteDescriptor::writeEncrypted(
-	EncryptedDescriptor &data,
-	const MTP::AuthKeyPtr &key) {
-	writeData(PrepareEncrypted(data, key));
+		EncryptedDescriptor &data,
+		const MTP::AuthKeyPtr &key) {
+	if (_finished) {
+		return;
+	}
+	data.finish();
+	_parts.push_back({ .data = base::take(data.data), .key = key });
 }
 
 void FileWriteDescriptor::finish() {
-	if (!_stream.device()) {
+	if (_finished) {
 		return;
 	}
-
-	_stream.setDevice(nullptr);
-	_md5.feed(&_fullSize, sizeof(_fullSize));
-	qint32 version = AppVersion;
-	_md5.feed(&version, sizeof(version));
-	_md5.feed(TdfMagic, TdfMagicLen);
-
-	_buffer.close();
+	_finished = true;
 
 	auto entry = WriteEntry{
 		.basePath = _basePath,
 		.base = _base,
-		.data = _safeData,
-		.md5 = QByteArray((const char*)_md5.result(), 0x10)
+		.parts = base::take(_parts),
 	};
 	if (_sync) {
 		Manager.writeSync(std::move(entry));
@@ -454,8 +474,12 @@ void FileWriteDescriptor::finish() {
 		EncryptedDescriptor &data,
 		const MTP::AuthKeyPtr &key) {
 	data.finish();
-	QByteArray &toEncrypt(data.data);
+	return PrepareEncrypted(data.data, key);
+}
 
+[[nodiscard]] QByteArray PrepareEncrypted(
+		QByteArray toEncrypt,
+		const MTP::AuthKeyPtr &key) {
 	// prepare for encryption
 	uint32 size = toEncrypt.size(), fullSize = size;
 	if (fullSize & 0x0F) {
@@ -626,35 +650,51 @@ bool ReadEncryptedFile(
 		const QString &name,
 		const QString &basePath,
 		const MTP::AuthKeyPtr &key) {
-	if (!ReadFile(result, name, basePath)) {
+	auto data = ReadEncryptedFileData(name, basePath, key);
+	if (!data) {
 		return false;
 	}
+	FillReadDescriptor(result, std::move(*data));
+	return true;
+}
+
+std::optional<DecryptedFileData> ReadEncryptedFileData(
+		const QString &name,
+		const QString &basePath,
+		const MTP::AuthKeyPtr &key) {
+	FileReadDescriptor file;
+	if (!ReadFile(file, name, basePath)) {
+		return std::nullopt;
+	}
 	QByteArray encrypted;
-	result.stream >> encrypted;
+	file.stream >> encrypted;
 
 	EncryptedDescriptor data;
 	if (!DecryptLocal(data, encrypted, key)) {
-		result.stream.setDevice(nullptr);
-		if (result.buffer.isOpen()) result.buffer.close();
-		result.buffer.setBuffer(nullptr);
-		result.data = QByteArray();
-		result.version = 0;
-		return false;
+		return std::nullopt;
 	}
+	return DecryptedFileData{
+		.version = file.version,
+		.data = data.data,
+		.position = data.buffer.pos(),
+	};
+}
 
-	result.stream.setDevice(0);
+void FillReadDescriptor(
+		FileReadDescriptor &result,
+		DecryptedFileData &&data) {
+	result.stream.setDevice(nullptr);
 	if (result.buffer.isOpen()) {
 		result.buffer.close();
 	}
-	result.buffer.setBuffer(0);
-	result.data = data.data;
+	result.buffer.setBuffer(nullptr);
+	result.version = data.version;
+	result.data = std::move(data.data);
 	result.buffer.setBuffer(&result.data);
 	result.buffer.open(QIODevice::ReadOnly);
-	result.buffer.seek(data.buffer.pos());
+	result.buffer.seek(data.position);
 	result.stream.setDevice(&result.buffer);
 	result.stream.setVersion(QDataStream::Qt_5_1);
-
-	return true;
 }
 
 bool ReadEncryptedFile(
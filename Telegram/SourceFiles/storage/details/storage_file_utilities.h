@@ -51,9 +51,18 @@ struct EncryptedDescriptor final {
 [[nodiscard]] QByteArray PrepareEncrypted(
 	EncryptedDescriptor &data,
 	const MTP::AuthKeyPtr &key);
+[[nodiscard]] QByteArray PrepareEncrypted(
+	QByteArray toEncrypt,
+	const MTP::AuthKeyPtr &key);
 
 class FileWriteDescriptor final {
 public:
+	// Parts are encrypted and framed on the writer thread.
+	struct Part {
+		QByteArray data;
+		MTP::AuthKeyPtr key; // Encrypt the data with this key if not null.
+	};
+
 	FileWriteDescriptor(
 		const FileKey &key,
 		const QString &basePath,
@@ -74,13 +83,10 @@ private:
 	void finish();
 
 	const QString _basePath;
-	QBuffer _buffer;
-	QDataStream _stream;
-	QByteArray _safeData;
+	std::vector<Part> _parts;
 	QString _base;
-	HashMd5 _md5;
-	int _fullSize = 0;
 	bool _sync = false;
+	bool _finished = false;
 
 };
 
@@ -106,6 +112,21 @@ bool ReadEncryptedFile(
 	const QString &basePath,
 	const MTP::AuthKeyPtr &key);
 
+// Reading and decrypting may be done on a background thread,
+// only filling the descriptor should be done where it is used.
+struct DecryptedFileData {
+	int32 version = 0;
+	QByteArray data;
+	qint64 position = 0;
+};
+[[nodiscard]] std::optional<DecryptedFileData> ReadEncryptedFileData(
+	const QString &name,
+	const QString &basePath,
+	const MTP::AuthKeyPtr &key);
+void FillReadDescriptor(
+	FileReadDescriptor &result,
+	DecryptedFileData &&data);
+
 void Sync();
 void Finish();
 
@@ -15,6 +15,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "core/application.h"
 #include "core/file_location.h"
 #include "storage/storage_account.h"
+#include "storage/storage_cache_policy.h"
 #include "storage/file_download_mtproto.h"
 #include "storage/file_download_web.h"
 #include "platform/platform_file_utilities.h"
@@ -280,8 +281,13 @@ void FileLoader::loadLocal(const Storage::Cache::Key &key) {
 				std::move(image));
 		});
 	};
-	_session->data().cache().get(key, [=, callback = std::move(done)](
+	const auto trace = _session->data().cacheAccessTrace();
+	const auto tag = _cacheTag;
+	_session->data().cacheGetForTag(key, tag, [=, callback = std::move(done)](
 			QByteArray &&value) mutable {
+		if (trace && !value.isEmpty()) {
+			trace->record(key, tag, value.size());
+		}
 		if (readImage && !value.startsWith("partial:")) {
 			crl::async([
 				value = std::move(value),
@@ -458,7 +464,10 @@ bool FileLoader::finalizeResult() {
 		if ((_toCache == LoadToCacheAsWell)
 			&& (_data.size() <= Storage::kMaxFileInMemory)
 			&& (key.low || key.high)) {
-			_session->data().cache().put(
+			if (const auto trace = _session->data().cacheAccessTrace()) {
+				trace->record(key, _cacheTag, _data.size());
+			}
+			_session->data().cacheForTag(_cacheTag).put(
 				cacheKey(),
 				Storage::Cache::Database::TaggedValue(
 					base::duplicate((!_fullSize || _data.size() == _fullSize)
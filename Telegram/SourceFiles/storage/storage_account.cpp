@@ -511,6 +511,7 @@ void Account::writeMap() {
 		return;
 	}
 	_mapChanged = false;
+	const auto ms = crl::now();
 
 	if (!QDir().exists(_basePath)) {
 		QDir().mkpath(_basePath);
@@ -643,6 +644,8 @@ void Account::writeMap() {
 	map.writeEncrypted(mapData, _localKey);
 
 	_mapChanged = false;
+
+	DEBUG_LOG(("Map write time: %1").arg(crl::now() - ms));
 }
 
 void Account::reset() {
@@ -670,6 +673,7 @@ void Account::reset() {
 	_settingsKey = _recentHashtagsAndBotsKey = _exportSettingsKey = 0;
 	_searchSuggestionsKey = 0;
 	_oldMapVersion = 0;
+	clearPreloadedFiles();
 	_fileLocations.clear();
 	_fileLocationPairs.clear();
 	_fileLocationAliases.clear();
@@ -727,6 +731,7 @@ void Account::writeLocations() {
 		return;
 	}
 	_locationsChanged = false;
+	const auto ms = crl::now();
 
 	if (_downloadsSerialize) {
 		if (auto serialized = _downloadsSerialize()) {
@@ -798,6 +803,8 @@ void Account::writeLocations() {
 		FileWriteDescriptor file(_locationsKey, _basePath);
 		file.writeEncrypted(data, _localKey);
 	}
+
+	DEBUG_LOG(("Locations write time: %1").arg(crl::now() - ms));
 }
 
 void Account::writeLocationsQueued() {
@@ -1797,6 +1804,9 @@ void Account::writeStickerSets(
 		const Data::StickersSetsOrder &order) {
 	using SetFlag = Data::StickersSetFlag;
 
+	// Sets that were not read from the disk yet would be lost.
+	_owner->session().readDeferredLocalData();
+
 	const auto &sets = _owner->session().data().stickers().sets();
 	if (sets.empty()) {
 		if (stickersKey) {
@@ -1900,7 +1910,7 @@ void Account::readStickerSets(
 	using SetFlag = Data::StickersSetFlag;
 
 	FileReadDescriptor stickers;
-	if (!ReadEncryptedFile(stickers, stickersKey, _basePath, _localKey)) {
+	if (!readEncryptedFile(stickers, stickersKey)) {
 		ClearKey(stickersKey, _basePath);
 		stickersKey = 0;
 		writeMapDelayed();
@@ -2519,7 +2529,69 @@ void Account::readInstalledCustomEmoji() {
 		Data::StickersSetFlag::Installed);
 }
 
+void Account::preloadStickersFiles(Fn<void()> done) {
+	const auto keys = std::vector<FileKey>{
+		_installedMasksKey,
+		_featuredStickersKey,
+		_featuredCustomEmojiKey,
+		_recentMasksKey,
+		_favedStickersKey,
+		_savedGifsKey,
+	} | ranges::views::filter([](FileKey key) {
+		return key != 0;
+	}) | ranges::to_vector;
+
+	const auto id = ++_preloadFilesId;
+	const auto weak = base::make_weak(_owner);
+	crl::async([=, basePath = _basePath, localKey = _localKey] {
+		auto files = base::flat_map<
+			FileKey,
+			std::shared_ptr<DecryptedFileData>>();
+		for (const auto key : keys) {
+			auto data = ReadEncryptedFileData(
+				ToFilePart(key),
+				basePath,
+				localKey);
+			files.emplace(key, data
+				? std::make_shared<DecryptedFileData>(std::move(*data))
+				: nullptr);
+		}
+		crl::on_main(weak, [=, files = std::move(files)] {
+			if (_preloadFilesId != id) {
+				return;
+			}
+			for (const auto &[key, data] : files) {
+				_preloadedFiles[key] = data
+					? std::make_unique<DecryptedFileData>(std::move(*data))
+					: nullptr;
+			}
+			done();
+		});
+	});
+}
+
+void Account::clearPreloadedFiles() {
+	++_preloadFilesId;
+	_preloadedFiles.clear();
+}
+
+bool Account::readEncryptedFile(FileReadDescriptor &result, FileKey key) {
+	const auto i = _preloadedFiles.find(key);
+	if (i == end(_preloadedFiles)) {
+		return ReadEncryptedFile(result, key, _basePath, _localKey);
+	}
+	const auto data = std::move(i->second);
+	_preloadedFiles.erase(i);
+	if (!data) {
+		return false;
+	}
+	FillReadDescriptor(result, std::move(*data));
+	return true;
+}
+
 void Account::writeSavedGifs() {
+	_owner->session().readDeferredLocalData();
+
 	const auto &saved = _owner->session().data().stickers().savedGifs();
 	if (saved.isEmpty()) {
 		if (_savedGifsKey) {
@@ -2551,7 +2623,7 @@ void Account::readSavedGifs() {
 	if (!_savedGifsKey) return;
 
 	FileReadDescriptor gifs;
-	if (!ReadEncryptedFile(gifs, _savedGifsKey, _basePath, _localKey)) {
+	if (!readEncryptedFile(gifs, _savedGifsKey)) {
 		ClearKey(_savedGifsKey, _basePath);
 		_savedGifsKey = 0;
 		writeMapDelayed();
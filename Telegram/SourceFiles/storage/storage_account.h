@@ -43,6 +43,7 @@ namespace Storage {
 namespace details {
 struct ReadSettingsContext;
 struct FileReadDescriptor;
+struct DecryptedFileData;
 } // namespace details
 
 class EncryptionKey;
@@ -141,6 +142,11 @@ public:
 	void readInstalledCustomEmoji();
 	void readFeaturedCustomEmoji();
 
+	// Reads and decrypts the sticker sets files that are not needed right
+	// at startup on a background thread, read*() then only parse them.
+	void preloadStickersFiles(Fn<void()> done);
+	void clearPreloadedFiles();
+
 	void writeRecentHashtagsAndBots();
 	void readRecentHashtagsAndBots();
 	void saveRecentSentHashtags(const QString &text);
@@ -249,6 +255,9 @@ private:
 		FileKey &stickersKey,
 		Data::StickersSetsOrder *outOrder = nullptr,
 		Data::StickersSetFlags readingFlags = 0);
+	[[nodiscard]] bool readEncryptedFile(
+		details::FileReadDescriptor &result,
+		FileKey key);
 	void importOldRecentStickers();
 
 	void readTrustedBots();
@@ -319,6 +328,11 @@ private:
 
 	int _oldMapVersion = 0;
 
+	base::flat_map<
+		FileKey,
+		std::unique_ptr<details::DecryptedFileData>> _preloadedFiles;
+	uint64 _preloadFilesId = 0;
+
 	base::Timer _writeMapTimer;
 	base::Timer _writeLocationsTimer;
 	base::Timer _writeSearchSuggestionsTimer;
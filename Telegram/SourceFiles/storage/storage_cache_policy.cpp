@@ -0,0 +1,471 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#include "storage/storage_cache_policy.h"
+
+#include "base/options.h"
+
+#include <list>
+#include <set>
+#include <unordered_map>
+
+namespace Storage {
+namespace {
+
+constexpr auto kTraceFlushCount = 1024;
+constexpr auto kTraceMaxSize = int64(16 * 1024 * 1024);
+constexpr auto kProtectedPart = 0.8;
+
+struct KeyHash {
+	size_t operator()(const Cache::Key &key) const {
+		constexpr auto kMultiplier = 0x9E3779B97F4A7C15ULL;
+		return std::hash<uint64>()(key.high ^ (key.low * kMultiplier));
+	}
+};
+
+base::options::toggle OptionCacheAccessTrace({
+	.id = kOptionCacheAccessTrace,
+	.name = "Record cache access trace",
+	.description = "Record cache accesses and compare eviction policies"
+		" on them, the results are written to the log.",
+});
+
+class LruPolicy final : public CachePolicy {
+public:
+	explicit LruPolicy(int64 capacity);
+
+	bool access(const CacheAccess &access) override;
+	int64 usedSize() const override;
+
+private:
+	using List = std::list<CacheAccess>;
+
+	const int64 _capacity = 0;
+	List _list;
+	std::unordered_map<Cache::Key, List::iterator, KeyHash> _index;
+	int64 _used = 0;
+
+};
+
+// Entries seen once stay in the probation segment, so that a burst of
+// cold entries (like a scrolled through video album) doesn't wash out
+// the entries that are requested again and again. Entries with frequent
+// tags are admitted right into the protected segment.
+class SegmentedLruPolicy final : public CachePolicy {
+public:
+	SegmentedLruPolicy(int64 capacity, const CacheTagWeights &weights);
+
+	bool access(const CacheAccess &access) override;
+	int64 usedSize() const override;
+
+private:
+	using List = std::list<CacheAccess>;
+	struct Entry {
+		List::iterator i;
+		bool isProtected = false;
+	};
+
+	void shrinkProtected();
+	void shrinkProbation();
+
+	const int64 _capacity = 0;
+	const int64 _protectedCapacity = 0;
+	const CacheTagWeights _weights;
+	List _probation;
+	List _protected;
+	std::unordered_map<Cache::Key, Entry, KeyHash> _index;
+	int64 _probationUsed = 0;
+	int64 _protectedUsed = 0;
+
+};
+
+// Greedy-Dual-Size-Frequency: priority is frequency * cost / size plus
+// the inflation value, so small hot entries outlive large cold ones.
+// The cost of a miss is taken from the weight of the entry tag.
+class GdsfPolicy final : public CachePolicy {
+public:
+	GdsfPolicy(int64 capacity, const CacheTagWeights &weights);
+
+	bool access(const CacheAccess &access) override;
+	int64 usedSize() const override;
+
+private:
+	struct Entry {
+		int64 size = 0;
+		int64 frequency = 0;
+		double cost = 1.;
+		double priority = 0.;
+		uint64 order = 0;
+	};
+	using Queue = std::set<std::tuple<double, uint64, Cache::Key>>;
+
+	void push(const Cache::Key &key, Entry &entry);
+
+	const int64 _capacity = 0;
+	const CacheTagWeights _weights;
+	std::unordered_map<Cache::Key, Entry, KeyHash> _index;
+	Queue _queue;
+	double _inflation = 0.;
+	uint64 _order = 0;
+	int64 _used = 0;
+
+};
+
+[[nodiscard]] CacheTagWeight LookupWeight(
+		const CacheTagWeights &weights,
+		uint8 tag) {
+	const auto i = weights.find(tag);
+	return (i != end(weights)) ? i->second : CacheTagWeight();
+}
+
+LruPolicy::LruPolicy(int64 capacity) : _capacity(capacity) {
+}
+
+bool LruPolicy::access(const CacheAccess &access) {
+	const auto i = _index.find(access.key);
+	if (i != end(_index)) {
+		_list.splice(end(_list), _list, i->second);
+		return true;
+	} else if (access.size > _capacity) {
+		return false;
+	}
+	while (_used + access.size > _capacity) {
+		_used -= _list.front().size;
+		_index.erase(_list.front().key);
+		_list.pop_front();
+	}
+	_used += access.size;
+	_index.emplace(access.key, _list.insert(end(_list), access));
+	return false;
+}
+
+int64 LruPolicy::usedSize() const {
+	return _used;
+}
+
+SegmentedLruPolicy::SegmentedLruPolicy(
+	int64 capacity,
+	const CacheTagWeights &weights)
+: _capacity(capacity)
+, _protectedCapacity(int64(capacity * kProtectedPart))
+, _weights(weights) {
+}
+
+bool SegmentedLruPolicy::access(const CacheAccess &access) {
+	const auto i = _index.find(access.key);
+	if (i != end(_index)) {
+		auto &entry = i->second;
+		if (entry.isProtected) {
+			_protected.splice(end(_protected), _protected, entry.i);
+		} else {
+			const auto size = entry.i->size;
+			_protected.splice(end(_protected), _probation, entry.i);
+			_probationUsed -= size;
+			_protectedUsed += size;
+			entry.isProtected = true;
+			shrinkProtected();
+		}
+		return true;
+	} else if (access.size > _capacity) {
+		return false;
+	} else if (LookupWeight(_weights, access.tag).frequent
+		&& access.size <= _protectedCapacity) {
+		_protectedUsed += access.size;
+		_index.emplace(access.key, Entry{
+			.i = _protected.insert(end(_protected), access),
+			.isProtected = true,
+		});
+		shrinkProtected();
+		return false;
+	}
+	_probationUsed += access.size;
+	_index.emplace(access.key, Entry{
+		.i = _probation.insert(end(_probation), access),
+	});
+	shrinkProbation();
+	return false;
+}
+
+void SegmentedLruPolicy::shrinkProtected() {
+	while (_protectedUsed > _protectedCapacity && !_protected.empty()) {
+		const auto first = begin(_protected);
+		const auto size = first->size;
+		_index[first->key].isProtected = false;
+		_probation.splice(end(_probation), _protected, first);
+		_protectedUsed -= size;
+		_probationUsed += size;
+	}
+	shrinkProbation();
+}
+
+void SegmentedLruPolicy::shrinkProbation() {
+	while (_probationUsed + _protectedUsed > _capacity) {
+		auto &list = _probation.empty() ? _protected : _probation;
+		auto &used = _probation.empty() ? _protectedUsed : _probationUsed;
+		used -= list.front().size;
+		_index.erase(list.front().key);
+		list.pop_front();
+	}
+}
+
+int64 SegmentedLruPolicy::usedSize() const {
+	return _probationUsed + _protectedUsed;
+}
+
+GdsfPolicy::GdsfPolicy(int64 capacity, const CacheTagWeights &weights)
+: _capacity(capacity)
+, _weights(weights) {
+}
+
+void GdsfPolicy::push(const Cache::Key &key, Entry &entry) {
+	entry.priority = _inflation
+		+ (double(entry.frequency) * entry.cost
+			/ double(std::max(entry.size, int64(1))));
+	entry.order = ++_order;
+	_queue.emplace(entry.priority, entry.order, key);
+}
+
+bool GdsfPolicy::access(const CacheAccess &access) {
+	const auto i = _index.find(access.key);
+	if (i != end(_index)) {
+		auto &entry = i->second;
+		_queue.erase({ entry.priority, entry.order, access.key });
+		++entry.frequency;
+		push(access.key, entry);
+		return true;
+	} else if (access.size > _capacity) {
+		return false;
+	}
+	while (_used + access.size > _capacity) {
+		const auto &[priority, order, key] = *begin(_queue);
+		_inflation = priority;
+		const auto j = _index.find(key);
+		_used -= j->second.size;
+		_index.erase(j);
+		_queue.erase(begin(_queue));
+	}
+	_used += access.size;
+	auto &entry = _index[access.key];
+	entry.size = access.size;
+	entry.frequency = 1;
+	entry.cost = LookupWeight(_weights, access.tag).cost;
+	push(access.key, entry);
+	return false;
+}
+
+int64 GdsfPolicy::usedSize() const {
+	return _used;
+}
+
+[[nodiscard]] QString PolicyName(CachePolicyType type) {
+	switch (type) {
+	case CachePolicyType::Lru: return u"LRU"_q;
+	case CachePolicyType::SegmentedLru: return u"SLRU"_q;
+	case CachePolicyType::Gdsf: return u"GDSF"_q;
+	}
+	Unexpected("Type in PolicyName.");
+}
+
+[[nodiscard]] QString FormatStats(const CacheTagStats &stats) {
+	const auto ratio = [](int64 part, int64 full) {
+		return full ? (part * 100. / full) : 0.;
+	};
+	return u"%1% hits (%2 / %3), %4% bytes"_q
+		.arg(ratio(stats.hits, stats.requests), 0, 'f', 1)
+		.arg(stats.hits)
+		.arg(stats.requests)
+		.arg(ratio(stats.hitBytes, stats.requestedBytes), 0, 'f', 1);
+}
+
+} // namespace
+
+const char kOptionCacheAccessTrace[] = "cache-access-trace";
+
+bool CacheAccessTraceEnabled() {
+	return OptionCacheAccessTrace.value();
+}
+
+std::unique_ptr<CachePolicy> CreateCachePolicy(
+		CachePolicyType type,
+		int64 capacity,
+		const CacheTagWeights &weights) {
+	switch (type) {
+	case CachePolicyType::Lru:
+		return std::make_unique<LruPolicy>(capacity);
+	case CachePolicyType::SegmentedLru:
+		return std::make_unique<SegmentedLruPolicy>(capacity, weights);
+	case CachePolicyType::Gdsf:
+		return std::make_unique<GdsfPolicy>(capacity, weights);
+	}
+	Unexpected("Type in CreateCachePolicy.");
+}
+
+std::vector<CacheSimulationResult> SimulateCachePolicies(
+		const std::vector<CacheAccess> &trace,
+		int64 capacity,
+		const CacheTagWeights &weights) {
+	const auto types = {
+		CachePolicyType::Lru,
+		CachePolicyType::SegmentedLru,
+		CachePolicyType::Gdsf,
+	};
+	auto result = std::vector<CacheSimulationResult>();
+	result.reserve(types.size());
+	for (const auto type : types) {
+		const auto policy = CreateCachePolicy(type, capacity, weights);
+		auto &simulation = result.emplace_back(CacheSimulationResult{
+			.type = type,
+		});
+		for (const auto &access : trace) {
+			const auto hit = policy->access(access);
+			for (const auto stats : {
+					&simulation.total,
+					&simulation.tags[access.tag] }) {
+				++stats->requests;
+				stats->requestedBytes += access.size;
+				if (hit) {
+					++stats->hits;
+					stats->hitBytes += access.size;
+				}
+			}
+		}
+	}
+	return result;
+}
+
+QString CacheSimulationReport(
+		const std::vector<CacheSimulationResult> &results) {
+	auto lines = QStringList();
+	for (const auto &result : results) {
+		lines.push_back(PolicyName(result.type)
+			+ u": "_q
+			+ FormatStats(result.total));
+		for (const auto &[tag, stats] : result.tags) {
+			lines.push_back(u"  tag %1: "_q.arg(tag) + FormatStats(stats));
+		}
+	}
+	return lines.join('\n');
+}
+
+struct CacheAccessTrace::State {
+	explicit State(QString path) : path(std::move(path)) {
+	}
+
+	const QString path;
+	QMutex mutex;
+	std::vector<CacheAccess> pending;
+	bool writeScheduled = false;
+
+	// All file operations are done under this one, so appends from
+	// different threads never interleave and batches keep their order.
+	QMutex fileMutex;
+};
+
+namespace {
+
+void WriteAccesses(
+		const QString &path,
+		const std::vector<CacheAccess> &accesses) {
+	auto file = QFile(path);
+	if (!file.open(QIODevice::WriteOnly | QIODevice::Append)) {
+		return;
+	}
+	auto stream = QDataStream(&file);
+	for (const auto &access : accesses) {
+		stream
+			<< quint64(access.key.high)
+			<< quint64(access.key.low)
+			<< qint64(access.size)
+			<< quint8(access.tag);
+	}
+	const auto size = file.size();
+	file.close();
+	if (size >= kTraceMaxSize) {
+		const auto old = path + u".old"_q;
+		QFile::remove(old);
+		QFile::rename(path, old);
+	}
+}
+
+void ReadAccesses(const QString &path, std::vector<CacheAccess> &result) {
+	auto file = QFile(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return;
+	}
+	auto stream = QDataStream(&file);
+	while (!stream.atEnd()) {
+		auto high = quint64();
+		auto low = quint64();
+		auto size = qint64();
+		auto tag = quint8();
+		stream >> high >> low >> size >> tag;
+		if (stream.status() != QDataStream::Ok) {
+			break;
+		}
+		result.push_back({
+			.key = Cache::Key{ high, low },
+			.size = size,
+			.tag = tag,
+		});
+	}
+}
+
+} // namespace
+
+void CacheAccessTrace::WritePending(const std::shared_ptr<State> &state) {
+	QMutexLocker file(&state->fileMutex);
+	auto pending = [&] {
+		QMutexLocker lock(&state->mutex);
+		state->writeScheduled = false;
+		return base::take(state->pending);
+	}();
+	if (!pending.empty()) {
+		WriteAccesses(state->path, pending);
+	}
+}
+
+CacheAccessTrace::CacheAccessTrace(QString path)
+: _state(std::make_shared<State>(std::move(path))) {
+}
+
+CacheAccessTrace::~CacheAccessTrace() {
+	flush();
+}
+
+void CacheAccessTrace::record(const Cache::Key &key, uint8 tag, int64 size) {
+	QMutexLocker lock(&_state->mutex);
+	_state->pending.push_back({ .key = key, .size = size, .tag = tag });
+	if (_state->pending.size() < kTraceFlushCount
+		|| _state->writeScheduled) {
+		return;
+	}
+	_state->writeScheduled = true;
+	lock.unlock();
+
+	crl::async([state = _state] {
+		WritePending(state);
+	});
+}
+
+void CacheAccessTrace::flush() {
+	WritePending(_state);
+}
+
+std::vector<CacheAccess> CacheAccessTrace::take() {
+	WritePending(_state);
+
+	QMutexLocker file(&_state->fileMutex);
+	const auto old = _state->path + u".old"_q;
+	auto result = std::vector<CacheAccess>();
+	ReadAccesses(old, result);
+	ReadAccesses(_state->path, result);
+	QFile::remove(old);
+	QFile::remove(_state->path);
+	return result;
+}
+
+} // namespace Storage
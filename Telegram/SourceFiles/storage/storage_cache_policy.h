@@ -0,0 +1,99 @@
+/*
+This file is part of Telegram Desktop,
+the official desktop application for the Telegram messaging service.
+
+For license and copyright information please follow this link:
+https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
+*/
+#pragma once
+
+#include "storage/cache/storage_cache_types.h"
+
+namespace Storage {
+
+struct CacheAccess {
+	Cache::Key key;
+	int64 size = 0;
+	uint8 tag = 0;
+};
+
+// How much a miss of an entry with this tag costs, relative to its size.
+// Frequent tags are expected to be requested again soon after the first
+// access, like stickers that are shown in many chats.
+struct CacheTagWeight {
+	double cost = 1.;
+	bool frequent = false;
+};
+using CacheTagWeights = base::flat_map<uint8, CacheTagWeight>;
+
+enum class CachePolicyType : uchar {
+	Lru,
+	SegmentedLru,
+	Gdsf,
+};
+
+class CachePolicy {
+public:
+	virtual ~CachePolicy() = default;
+
+	// Returns true on a hit, otherwise the entry is admitted.
+	virtual bool access(const CacheAccess &access) = 0;
+
+	[[nodiscard]] virtual int64 usedSize() const = 0;
+
+};
+
+[[nodiscard]] std::unique_ptr<CachePolicy> CreateCachePolicy(
+	CachePolicyType type,
+	int64 capacity,
+	const CacheTagWeights &weights);
+
+struct CacheTagStats {
+	int64 requests = 0;
+	int64 hits = 0;
+	int64 requestedBytes = 0;
+	int64 hitBytes = 0;
+};
+
+struct CacheSimulationResult {
+	CachePolicyType type = CachePolicyType::Lru;
+	CacheTagStats total;
+	base::flat_map<uint8, CacheTagStats> tags;
+};
+
+[[nodiscard]] std::vector<CacheSimulationResult> SimulateCachePolicies(
+	const std::vector<CacheAccess> &trace,
+	int64 capacity,
+	const CacheTagWeights &weights);
+[[nodiscard]] QString CacheSimulationReport(
+	const std::vector<CacheSimulationResult> &results);
+
+// Records accesses of the cache databases to replay them in simulation.
+// Thread-safe, the cache callbacks are called on the database threads.
+// The file is rotated when it grows too big, so the trace is bounded.
+class CacheAccessTrace final {
+public:
+	explicit CacheAccessTrace(QString path);
+	~CacheAccessTrace();
+
+	void record(const Cache::Key &key, uint8 tag, int64 size);
+	void flush();
+
+	// Blocks while the pending accesses are written. The returned
+	// accesses are removed from the trace, so each is replayed once.
+	[[nodiscard]] std::vector<CacheAccess> take();
+
+private:
+	struct State;
+
+	static void WritePending(const std::shared_ptr<State> &state);
+
+	const std::shared_ptr<State> _state;
+
+};
+
+extern const char kOptionCacheAccessTrace[];
+
+[[nodiscard]] bool CacheAccessTraceEnabled();
+
+} // namespace Storage
@@ -8,6 +8,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "storage/storage_domain.h"
 
 #include "storage/details/storage_file_utilities.h"
+#include "storage/storage_encryption.h"
 #include "storage/serialize_common.h"
 #include "mtproto/mtproto_config.h"
 #include "main/main_domain.h"
@@ -29,6 +30,10 @@ using namespace details;
 	return "key_" + dataName;
 }
 
+[[nodiscard]] QString ComputeSharedDatabasePath(const QString &dataName) {
+	return BaseGlobalPath() + "shared_" + dataName + '/';
+}
+
 } // namespace
 
 Domain::Domain(not_null<Main::Domain*> owner, const QString &dataName)
@@ -41,7 +46,7 @@ Domain::~Domain() = default;
 StartResult Domain::start(const QByteArray &passcode) {
 	const auto modern = startModern(passcode);
 	if (modern == StartModernResult::Success) {
-		if (_oldVersion < AppVersion) {
+		if (_oldVersion < AppVersion || !_sharedCacheKey) {
 			writeAccounts();
 		}
 		return StartResult::Success;
@@ -74,6 +79,7 @@ void Domain::startWithSingleAccount(
 		std::unique_ptr<Main::Account> account) {
 	Expects(account != nullptr);
 
+	generateSharedCacheKey();
 	if (auto localKey = account->local().peekLegacyLocalKey()) {
 		_localKey = std::move(localKey);
 		encryptLocalKey(passcode);
@@ -102,6 +108,12 @@ void Domain::generateLocalKey() {
 	encryptLocalKey(QByteArray());
 }
 
+void Domain::generateSharedCacheKey() {
+	auto key = MTP::AuthKey::Data();
+	base::RandomFill(key.data(), key.size());
+	_sharedCacheKey = std::make_shared<MTP::AuthKey>(key);
+}
+
 void Domain::encryptLocalKey(const QByteArray &passcode) {
 	_passcodeKeySalt.resize(LocalEncryptSaltSize);
 	base::RandomFill(_passcodeKeySalt.data(), _passcodeKeySalt.size());
@@ -167,12 +179,33 @@ Domain::StartModernResult Domain::startModern(
 
 	_oldVersion = keyData.version;
 
+	auto indices = std::vector<qint32>(count);
+	for (auto &index : indices) {
+		info.stream >> index;
+	}
+	auto active = std::optional<qint32>();
+	if (!info.stream.atEnd()) {
+		info.stream >> active.emplace();
+	}
+
+	// The shared cache key is read before the accounts are started,
+	// because their sessions open the shared cache right away.
+	if (!info.stream.atEnd()) {
+		const auto cacheKey = Serialize::read<MTP::AuthKey::Data>(
+			info.stream);
+		if (CheckStreamStatus(info.stream)) {
+			_sharedCacheKey = std::make_shared<MTP::AuthKey>(cacheKey);
+		}
+	}
+	if (!_sharedCacheKey) {
+		generateSharedCacheKey();
+	}
+
 	auto tried = base::flat_set<int>();
 	auto sessions = base::flat_set<uint64>();
-	auto active = 0;
+	auto first = 0;
 	for (auto i = 0; i != count; ++i) {
-		auto index = qint32();
-		info.stream >> index;
+		const auto index = indices[i];
 		if (index >= 0
 			&& index < Main::Domain::kPremiumMaxAccounts
 			&& tried.emplace(index).second) {
@@ -186,7 +219,7 @@ Domain::StartModernResult Domain::startModern(
 			if (!sessions.contains(sessionId)
 				&& (sessionId != 0 || (sessions.empty() && i + 1 == count))) {
 				if (sessions.empty()) {
-					active = index;
+					first = index;
 				}
 				account->start(std::move(config));
 				_owner->accountAddedInStorage({
@@ -202,10 +235,7 @@ Domain::StartModernResult Domain::startModern(
 		return StartModernResult::Failed;
 	}
 
-	if (!info.stream.atEnd()) {
-		info.stream >> active;
-	}
-	_owner->activateFromStorage(active);
+	_owner->activateFromStorage(active.value_or(first));
 
 	Ensures(!sessions.empty());
 	return StartModernResult::Success;
@@ -213,6 +243,7 @@ Domain::StartModernResult Domain::startModern(
 
 void Domain::writeAccounts() {
 	Expects(!_owner->accounts().empty());
+	Expects(_sharedCacheKey != nullptr);
 
 	const auto path = BaseGlobalPath();
 	if (!QDir().exists(path)) {
@@ -225,7 +256,10 @@ void Domain::writeAccounts() {
 
 	const auto &list = _owner->accounts();
 
-	auto keySize = sizeof(qint32) + sizeof(qint32) * list.size();
+	auto keySize = sizeof(qint32)
+		+ sizeof(qint32) * list.size()
+		+ sizeof(qint32)
+		+ MTP::AuthKey::kSize;
 
 	EncryptedDescriptor keyData(keySize);
 	keyData.stream << qint32(list.size());
@@ -233,6 +267,7 @@ void Domain::writeAccounts() {
 		keyData.stream << qint32(index);
 	}
 	keyData.stream << qint32(_owner->activeForStorage());
+	_sharedCacheKey->write(keyData.stream);
 	key.writeEncrypted(keyData, _localKey);
 }
 
@@ -260,6 +295,24 @@ void Domain::setPasscode(const QByteArray &passcode) {
 	_passcodeKeyChanged.fire({});
 }
 
+bool Domain::hasSharedCache() const {
+	return (_sharedCacheKey != nullptr);
+}
+
+EncryptionKey Domain::sharedCacheKey() const {
+	Expects(_sharedCacheKey != nullptr);
+
+	return EncryptionKey(bytes::make_vector(_sharedCacheKey->data()));
+}
+
+QString Domain::sharedCachePath() const {
+	return ComputeSharedDatabasePath(_dataName) + "cache";
+}
+
+QString Domain::sharedCacheBigFilePath() const {
+	return ComputeSharedDatabasePath(_dataName) + "media_cache";
+}
+
 int Domain::oldVersion() const {
 	return _oldVersion;
 }
@@ -20,6 +20,8 @@ class Domain;
 
 namespace Storage {
 
+class EncryptionKey;
+
 enum class StartResult : uchar {
 	Success,
 	IncorrectPasscode,
@@ -47,6 +49,13 @@ public:
 	[[nodiscard]] rpl::producer<> localPasscodeChanged() const;
 	[[nodiscard]] bool hasLocalPasscode() const;
 
+	// The shared cache of all the accounts has its own key,
+	// stored in the key file next to the local key.
+	[[nodiscard]] bool hasSharedCache() const;
+	[[nodiscard]] EncryptionKey sharedCacheKey() const;
+	[[nodiscard]] QString sharedCachePath() const;
+	[[nodiscard]] QString sharedCacheBigFilePath() const;
+
 private:
 	enum class StartModernResult {
 		Success,
@@ -60,12 +69,14 @@ private:
 		const QByteArray &passcode,
 		std::unique_ptr<Main::Account> account);
 	void generateLocalKey();
+	void generateSharedCacheKey();
 	void encryptLocalKey(const QByteArray &passcode);
 
 	const not_null<Main::Domain*> _owner;
 	const QString _dataName;
 
 	MTP::AuthKeyPtr _localKey;
+	MTP::AuthKeyPtr _sharedCacheKey;
 	MTP::AuthKeyPtr _passcodeKey;
 	QByteArray _passcodeKeySalt;
 	QByteArray _passcodeKeyEncrypted;
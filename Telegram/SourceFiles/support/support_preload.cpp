@@ -11,6 +11,7 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "data/data_peer.h"
 #include "data/data_session.h"
 #include "data/data_histories.h"
+#include "history/history_item.h"
 #include "main/main_session.h"
 #include "apiwrap.h"
 
@@ -18,10 +19,38 @@ namespace Support {
 namespace {
 
 constexpr auto kPreloadMessagesCount = 50;
+constexpr auto kPreloadDependentCount = 20;
+
+// Start loading what the first screen of the chat is going to show:
+// userpics of the senders and reply previews of the latest messages.
+void PreloadDependent(
+		not_null<History*> history,
+		const QVector<MTPMessage> &messages) {
+	history->peer->loadUserpic();
+	auto left = kPreloadDependentCount;
+	auto senders = base::flat_set<not_null<PeerData*>>();
+	for (const auto &message : messages) {
+		const auto id = IdFromMessage(message);
+		if (const auto item = history->owner().message(history->peer, id)) {
+			item->resolveDependent();
+			if (const auto from = item->from(); from != history->peer) {
+				if (senders.emplace(from).second) {
+					from->loadUserpic();
+				}
+			}
+		}
+		if (!--left) {
+			break;
+		}
+	}
+}
 
 } // namespace
 
-int SendPreloadRequest(not_null<History*> history, Fn<void()> retry) {
+int SendPreloadRequest(
+		not_null<History*> history,
+		Fn<void(bool)> done,
+		Fn<void()> retry) {
 	auto offsetId = MsgId();
 	auto offset = 0;
 	auto loadCount = kPreloadMessagesCount;
@@ -66,10 +95,13 @@ int SendPreloadRequest(not_null<History*> history, Fn<void()> retry) {
 				history->owner().processUsers(data.vusers());
 				history->owner().processChats(data.vchats());
 				history->addOlderSlice(data.vmessages().v);
+				PreloadDependent(history, data.vmessages().v);
 			});
 			finish();
+			done(true);
 		}).fail([=](const MTP::Error &error) {
 			finish();
+			done(false);
 		}).send();
 	});
 }
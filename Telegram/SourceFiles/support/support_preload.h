@@ -12,8 +12,10 @@ class History;
 namespace Support {
 
 // Returns histories().request, not api().request.
+// The done callback receives false if the request has failed.
 [[nodiscard]] int SendPreloadRequest(
 	not_null<History*> history,
+	Fn<void(bool)> done,
 	Fn<void()> retry);
 
 } // namespace Support
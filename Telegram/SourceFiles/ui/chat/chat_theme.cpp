@@ -19,6 +19,8 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include <crl/crl_async.h>
 #include <QtGui/QGuiApplication>
 
+#include <mutex>
+
 namespace Ui {
 namespace {
 
@@ -29,6 +31,183 @@ constexpr auto kMinimumTiledSize = 512;
 constexpr auto kMaxSize = 2960;
 constexpr auto kMaxContrastValue = 21.;
 constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
+constexpr auto kCachedBackgroundsCount = 8;
+constexpr auto kCachedBackgroundsBytes = int64(48 * 1024 * 1024);
+
+// Recently rendered backgrounds, shared by all the chat themes, so that
+// going back to a previous window size, cycling the gradient rotation
+// or opening one more window with the same theme doesn't render again.
+// The scaled pattern counts against the same bytes limit. When a chat
+// theme gets a new background, the renders of the old one are dropped.
+// It is accessed from
+// the crl::async() threads.
+class RenderedBackgrounds final {
+public:
+	[[nodiscard]] std::optional<CacheBackgroundResult> find(
+		const CacheBackgroundRequest &request);
+	void store(
+		const CacheBackgroundRequest &request,
+		const CacheBackgroundResult &result);
+
+	[[nodiscard]] QImage scaledPattern(const QImage &prepared, int size);
+	void forget(const ChatThemeBackground &background);
+
+private:
+	// Doesn't hold the source images, only their cache keys.
+	struct Key {
+		QString key;
+		qint64 prepared = 0;
+		qint64 preparedForTiled = 0;
+		qint64 gradientForFill = 0;
+		float64 patternOpacity = 1.;
+		float64 gradientProgress = 1.;
+		int gradientRotation = 0;
+		int gradientRotationAdd = 0;
+		QSize area;
+		int ratio = 0;
+		bool isPattern = false;
+		bool tile = false;
+
+		friend inline bool operator==(const Key &, const Key &) = default;
+	};
+	struct Entry {
+		Key key;
+		CacheBackgroundResult result;
+	};
+
+	[[nodiscard]] static Key ComputeKey(
+		const CacheBackgroundRequest &request);
+	[[nodiscard]] static int64 ComputeBytes(const Entry &entry);
+	void trim();
+
+	std::mutex _mutex;
+	std::deque<Entry> _entries;
+	int64 _bytes = 0;
+
+	qint64 _patternKey = 0;
+	int _patternSize = 0;
+	QImage _pattern;
+
+};
+
+std::optional<CacheBackgroundResult> RenderedBackgrounds::find(
+		const CacheBackgroundRequest &request) {
+	const auto key = ComputeKey(request);
+	auto lock = std::unique_lock(_mutex);
+	const auto i = ranges::find(_entries, key, &Entry::key);
+	if (i == end(_entries)) {
+		return std::nullopt;
+	}
+	auto result = i->result;
+	if (i != begin(_entries)) {
+		auto entry = std::move(*i);
+		_entries.erase(i);
+		_entries.push_front(std::move(entry));
+	}
+	return result;
+}
+
+void RenderedBackgrounds::store(
+		const CacheBackgroundRequest &request,
+		const CacheBackgroundResult &result) {
+	if (result.waitingForNegativePattern) {
+		return;
+	}
+	auto entry = Entry{ .key = ComputeKey(request), .result = result };
+	const auto bytes = ComputeBytes(entry);
+	if (bytes > kCachedBackgroundsBytes / 2) {
+		return;
+	}
+	auto lock = std::unique_lock(_mutex);
+	_entries.push_front(std::move(entry));
+	_bytes += bytes;
+	trim();
+}
+
+QImage RenderedBackgrounds::scaledPattern(const QImage &prepared, int size) {
+	auto lock = std::unique_lock(_mutex);
+	if (_patternKey == prepared.cacheKey() && _patternSize == size) {
+		return _pattern;
+	}
+	lock.unlock();
+
+	auto result = prepared.scaled(
+		size,
+		size,
+		Qt::KeepAspectRatio,
+		Qt::SmoothTransformation);
+
+	lock.lock();
+	_patternKey = prepared.cacheKey();
+	_patternSize = size;
+	_pattern = result;
+	trim();
+	return result;
+}
+
+void RenderedBackgrounds::forget(const ChatThemeBackground &background) {
+	const auto prepared = background.prepared.cacheKey();
+	const auto preparedForTiled = background.preparedForTiled.cacheKey();
+	const auto gradientForFill = background.gradientForFill.cacheKey();
+	auto lock = std::unique_lock(_mutex);
+	for (auto i = begin(_entries); i != end(_entries);) {
+		const auto &key = i->key;
+		if (key.key == background.key
+			&& key.prepared == prepared
+			&& key.preparedForTiled == preparedForTiled
+			&& key.gradientForFill == gradientForFill) {
+			_bytes -= ComputeBytes(*i);
+			i = _entries.erase(i);
+		} else {
+			++i;
+		}
+	}
+	if (_patternKey == prepared) {
+		_patternKey = 0;
+		_patternSize = 0;
+		_pattern = QImage();
+	}
+}
+
+void RenderedBackgrounds::trim() {
+	const auto limit = kCachedBackgroundsBytes - _pattern.sizeInBytes();
+	while (!_entries.empty()
+		&& (_entries.size() > kCachedBackgroundsCount || _bytes > limit)) {
+		_bytes -= ComputeBytes(_entries.back());
+		_entries.pop_back();
+	}
+}
+
+auto RenderedBackgrounds::ComputeKey(const CacheBackgroundRequest &request)
+-> Key {
+	const auto &background = request.background;
+	return {
+		.key = background.key,
+		.prepared = background.prepared.cacheKey(),
+		.preparedForTiled = background.preparedForTiled.cacheKey(),
+		.gradientForFill = background.gradientForFill.cacheKey(),
+		.patternOpacity = background.patternOpacity,
+		.gradientProgress = request.gradientProgress,
+		.gradientRotation = background.gradientRotation,
+		.gradientRotationAdd = request.gradientRotationAdd,
+		.area = request.area,
+		.ratio = style::DevicePixelRatio(),
+		.isPattern = background.isPattern,
+		.tile = background.tile,
+	};
+}
+
+int64 RenderedBackgrounds::ComputeBytes(const Entry &entry) {
+	return entry.result.image.sizeInBytes()
+		+ ((entry.result.gradient.cacheKey() == entry.key.gradientForFill)
+			? 0
+			: entry.result.gradient.sizeInBytes());
+}
+
+[[nodiscard]] RenderedBackgrounds &Rendered() {
+	static auto result = RenderedBackgrounds();
+	return result;
+}
 
 [[nodiscard]] QColor DefaultBackgroundColor() {
 	return QColor(213, 223, 233);
@@ -91,11 +270,9 @@ constexpr auto kMinAcceptableContrast = 1.14;// 4.5;
 				}
 			}
 			const auto tiled = request.background.isPattern
-				? request.background.prepared.scaled(
-					request.area.height() * ratio,
-					request.area.height() * ratio,
-					Qt::KeepAspectRatio,
-					Qt::SmoothTransformation)
+				? Rendered().scaledPattern(
+					request.background.prepared,
+					request.area.height() * ratio)
 				: request.background.preparedForTiled;
 			const auto w = tiled.width() / float(ratio);
 			const auto h = tiled.height() / float(ratio);
@@ -191,7 +368,12 @@ bool operator!=(
 
 CacheBackgroundResult CacheBackground(
 		const CacheBackgroundRequest &request) {
-	return CacheBackgroundByRequest(request);
+	if (auto cached = Rendered().find(request)) {
+		return std::move(*cached);
+	}
+	auto result = CacheBackgroundByRequest(request);
+	Rendered().store(request, result);
+	return result;
 }
 
 CachedBackground::CachedBackground(CacheBackgroundResult &&result)
@@ -210,7 +392,7 @@ ChatTheme::ChatTheme(ChatThemeDescriptor &&descriptor)
 : _key(descriptor.key)
 , _palette(std::make_unique<style::palette>()) {
 	descriptor.preparePalette(*_palette);
-	setBackground(PrepareBackgroundImage(descriptor.backgroundData));
+	_mutableBackground = PrepareBackgroundImage(descriptor.backgroundData);
 	setBubblesBackground(PrepareBubblesBackground(descriptor.bubblesData));
 	adjustPalette(descriptor);
 }
@@ -402,6 +584,7 @@ void ChatTheme::adjust(const style::color &my, const style::colorizer &by) {
 }
 
 void ChatTheme::setBackground(ChatThemeBackground &&background) {
+	Rendered().forget(_mutableBackground);
 	_mutableBackground = std::move(background);
 	_backgroundState = {};
 	_backgroundNext = {};
@@ -413,6 +596,7 @@ void ChatTheme::setBackground(ChatThemeBackground &&background) {
 }
 
 void ChatTheme::updateBackgroundImageFrom(ChatThemeBackground &&background) {
+	Rendered().forget(_mutableBackground);
 	_mutableBackground.key = background.key;
 	_mutableBackground.prepared = std::move(background.prepared);
 	_mutableBackground.preparedForTiled = std::move(
@@ -11,6 +11,130 @@ https://github.com/telegramdesktop/tdesktop/blob/master/LEGAL
 #include "ui/image/image_prepare.h"
 
 namespace Ui {
+namespace {
+
+constexpr auto kSharedCacheBytesLimit = int64(48 * 1024 * 1024);
+constexpr auto kLogStatsEvictedCount = 1024;
+
+struct SharedUserpicKey {
+	qint64 cloud = 0;
+	int size = 0;
+	int ratio = 0;
+	bool forum = false;
+
+	friend inline auto operator<=>(
+		const SharedUserpicKey &,
+		const SharedUserpicKey &) = default;
+	friend inline bool operator==(
+		const SharedUserpicKey &,
+		const SharedUserpicKey &) = default;
+};
+
+// Rounded userpic frames shared between all the views showing the same
+// photo in the same size. The views hold implicitly shared copies of the
+// images, so evicting an entry doesn't affect the views showing it.
+class SharedUserpicCache final {
+public:
+	[[nodiscard]] QImage get(const QImage &cloud, int size, bool forum);
+
+private:
+	struct Entry {
+		QImage image;
+		std::list<SharedUserpicKey>::iterator lru;
+	};
+
+	[[nodiscard]] static QImage Prepare(
+		const QImage &cloud,
+		int size,
+		bool forum);
+	[[nodiscard]] static int64 ComputeBytes(const QImage &image);
+	void evictLeastRecent();
+	[[nodiscard]] QString statsText() const;
+
+	base::flat_map<SharedUserpicKey, Entry> _entries;
+	std::list<SharedUserpicKey> _lru;
+	int64 _bytes = 0;
+	int64 _hits = 0;
+	int64 _misses = 0;
+	int64 _evicted = 0;
+
+};
+
+QImage SharedUserpicCache::get(const QImage &cloud, int size, bool forum) {
+	const auto key = SharedUserpicKey{
+		.cloud = cloud.cacheKey(),
+		.size = size,
+		.ratio = style::DevicePixelRatio(),
+		.forum = forum,
+	};
+	if (const auto i = _entries.find(key); i != end(_entries)) {
+		++_hits;
+		_lru.splice(end(_lru), _lru, i->second.lru);
+		return i->second.image;
+	}
+	++_misses;
+	auto image = Prepare(cloud, size, forum);
+	_bytes += ComputeBytes(image);
+	_lru.push_back(key);
+	_entries.emplace(key, Entry{ image, std::prev(end(_lru)) });
+	if (_bytes > kSharedCacheBytesLimit) {
+		evictLeastRecent();
+	}
+	return image;
+}
+
+QImage SharedUserpicCache::Prepare(
+		const QImage &cloud,
+		int size,
+		bool forum) {
+	auto result = cloud.scaled(
+		QSize(size, size),
+		Qt::IgnoreAspectRatio,
+		Qt::SmoothTransformation);
+	if (forum) {
+		return Images::Round(
+			std::move(result),
+			Images::CornersMask(size
+				* Ui::ForumUserpicRadiusMultiplier()
+				/ style::DevicePixelRatio()));
+	}
+	return Images::Circle(std::move(result));
+}
+
+int64 SharedUserpicCache::ComputeBytes(const QImage &image) {
+	return int64(image.bytesPerLine()) * image.height();
+}
+
+void SharedUserpicCache::evictLeastRecent() {
+	while (_bytes > kSharedCacheBytesLimit && _lru.size() > 1) {
+		const auto i = _entries.find(_lru.front());
+		Assert(i != end(_entries));
+		_bytes -= ComputeBytes(i->second.image);
+		_entries.erase(i);
+		_lru.pop_front();
+		if (!(++_evicted % kLogStatsEvictedCount)) {
+			DEBUG_LOG(("Userpic Cache: %1").arg(statsText()));
+		}
+	}
+}
+
+QString SharedUserpicCache::statsText() const {
+	const auto total = _hits + _misses;
+	return u"hits: %1, misses: %2 (%3%), evicted: %4, entries: %5, %6 KB"_q
+		.arg(_hits)
+		.arg(_misses)
+		.arg(total ? (_misses * 100 / total) : 0)
+		.arg(_evicted)
+		.arg(_entries.size())
+		.arg(_bytes / 1024);
+}
+
+[[nodiscard]] SharedUserpicCache &SharedCache() {
+	static auto result = SharedUserpicCache();
+	return result;
+}
+
+} // namespace
 
 float64 ForumUserpicRadiusMultiplier() {
 	return 0.3;
@@ -44,21 +168,9 @@ void ValidateUserpicCache(
 	view.paletteVersion = version;
 
 	if (cloud) {
-		view.cached = cloud->scaled(
-			full,
-			Qt::IgnoreAspectRatio,
-			Qt::SmoothTransformation);
-		if (forum) {
-			view.cached = Images::Round(
-				std::move(view.cached),
-				Images::CornersMask(size
-					* Ui::ForumUserpicRadiusMultiplier()
-					/ style::DevicePixelRatio()));
-		} else {
-			view.cached = Images::Circle(std::move(view.cached));
-		}
+		view.cached = SharedCache().get(*cloud, size, forum);
 	} else {
-		if (view.cached.size() != full) {
+		if (view.cached.size() != full || !view.cached.isDetached()) {
 			view.cached = QImage(full, QImage::Format_ARGB32_Premultiplied);
 		}
 		view.cached.fill(Qt::transparent);
@@ -54,6 +54,8 @@ constexpr auto kMinimalForwardDelay = crl::time(500);
 constexpr auto kMinimalAlertDelay = crl::time(500);
 constexpr auto kWaitingForAllGroupedDelay = crl::time(1000);
 constexpr auto kReactionNotificationEach = 60 * 60 * crl::time(1000);
+constexpr auto kDeliveryTokensLimit = 8;
+constexpr auto kDeliveryTokenEach = crl::time(750);
 
 #ifdef Q_OS_MAC
 constexpr auto kSystemAlertDuration = crl::time(1000);
@@ -149,7 +151,8 @@ System::NotificationInHistoryKey::NotificationInHistoryKey(
 System::System()
 : _waitTimer([=] { showNext(); })
 , _waitForAllGroupedTimer([=] { showGrouped(); })
-, _manager(std::make_unique<DummyManager>(this)) {
+, _manager(std::make_unique<DummyManager>(this))
+, _deliveryTokens(kDeliveryTokensLimit) {
 	settingsChanged(
 	) | rpl::start_with_next([=](ChangeType type) {
 		if (type == ChangeType::DesktopEnabled) {
@@ -546,6 +549,70 @@ void System::showGrouped() {
 	}
 }
 
+crl::time System::takeDeliveryToken(crl::time now) {
+	if (_deliveryTokens < kDeliveryTokensLimit) {
+		const auto refilled = (now - _deliveryTokensUpdated)
+			/ kDeliveryTokenEach;
+		if (refilled > 0) {
+			_deliveryTokens = int(std::min(
+				_deliveryTokens + refilled,
+				crl::time(kDeliveryTokensLimit)));
+			_deliveryTokensUpdated = (_deliveryTokens < kDeliveryTokensLimit)
+				? (_deliveryTokensUpdated + refilled * kDeliveryTokenEach)
+				: now;
+		}
+	}
+	if (!_deliveryTokens) {
+		return std::max(
+			_deliveryTokensUpdated + kDeliveryTokenEach - now,
+			kMinimalDelay);
+	} else if (_deliveryTokens-- == kDeliveryTokensLimit) {
+		_deliveryTokensUpdated = now;
+	}
+	return 0;
+}
+
+bool System::deliveryThrottled() const {
+	return (_deliveryTokens < kDeliveryTokensLimit / 2);
+}
+
+int System::collapseDueNotifications(
+		not_null<Data::Thread*> thread,
+		crl::time now) {
+	const auto j = _whenMaps.find(thread);
+	if (j == end(_whenMaps)) {
+		return 0;
+	}
+	const auto collapsible = [](const Data::ItemNotification &value) {
+		return (value.type == Data::ItemNotificationType::Message)
+			&& !value.item->Has<HistoryMessageForwarded>()
+			&& !value.item->groupId();
+	};
+	const auto &pending = thread->pendingNotifications();
+	if (pending.empty() || !collapsible(pending.front())) {
+		return 0;
+	}
+	auto last = 0;
+	for (auto k = 1, count = int(pending.size()); k != count; ++k) {
+		const auto &candidate = pending[k];
+		if (!collapsible(candidate)) {
+			break;
+		}
+		const auto i = j->second.find(candidate);
+		if (i == end(j->second) || i->second > now) {
+			break;
+		}
+		last = k;
+	}
+
+	// Show only the last one of the messages that are already due.
+	for (auto k = 0; k != last; ++k) {
+		j->second.remove(*thread->currentNotification());
+		thread->skipNotification();
+	}
+	return last;
+}
+
 void System::showNext() {
 	Expects(_manager != nullptr);
 
@@ -681,6 +748,20 @@ void System::showNext() {
 			}
 			_waitTimer.callOnce(next - ms);
 			break;
+		} else if (const auto delay = takeDeliveryToken(ms)) {
+			// Too many notifications were shown recently.
+			const auto wait = (nextAlert && nextAlert < ms + delay)
+				? (nextAlert - ms)
+				: delay;
+			nextAlert = 0;
+			_waitTimer.callOnce(wait);
+			break;
+		}
+		const auto collapsedCount = deliveryThrottled()
+			? collapseDueNotifications(notifyThread, ms)
+			: 0;
+		if (collapsedCount) {
+			notify = notifyThread->currentNotification();
 		}
 		const auto notifyItem = notify->item;
 		const auto messageType = (notify->type
@@ -794,6 +875,7 @@ void System::showNext() {
 					.forwardedCount = forwardedCount,
 					.reactionFrom = notify->reactionSender,
 					.reactionId = reaction,
+					.collapsedCount = collapsedCount,
 				});
 			}
 		}
@@ -1193,7 +1275,7 @@ void NativeManager::doShowNotification(NotificationFields &&fields) {
 		: options.hideNameAndPhoto
 		? QString()
 		: item->notificationHeader();
-	const auto text = reactionFrom
+	const auto message = reactionFrom
 		? TextWithPermanentSpoiler(ComposeReactionNotification(
 			item,
 			fields.reactionId,
@@ -1209,6 +1291,14 @@ void NativeManager::doShowNotification(NotificationFields &&fields) {
 				.spoilerLoginCode = options.spoilerLoginCode,
 			})),
 			(fields.forwardedCount == 1));
+	const auto text = (!reactionFrom && fields.collapsedCount > 0)
+		? (message
+			+ '\n'
+			+ tr::lng_notification_more_messages(
+				tr::now,
+				lt_count,
+				fields.collapsedCount))
+		: message;
 
 	// #TODO optimize
 	auto userpicView = item->history()->peer->createUserpicView();
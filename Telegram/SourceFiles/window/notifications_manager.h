@@ -175,6 +175,15 @@ private:
 	[[nodiscard]] bool skipReactionNotification(
 		not_null<HistoryItem*> item) const;
 
+	// Returns zero if a delivery token was taken,
+	// otherwise the time until the next one is available.
+	[[nodiscard]] crl::time takeDeliveryToken(crl::time now);
+	[[nodiscard]] bool deliveryThrottled() const;
+	// Returns the amount of skipped notifications.
+	int collapseDueNotifications(
+		not_null<Data::Thread*> thread,
+		crl::time now);
+
 	void showNext();
 	void showGrouped();
 	void ensureSoundCreated();
@@ -214,6 +223,9 @@ private:
 		not_null<Data::ForumTopic*>,
 		rpl::lifetime> _watchedTopics;
 
+	int _deliveryTokens = 0;
+	crl::time _deliveryTokensUpdated = 0;
+
 	int _lastForwardedCount = 0;
 	uint64 _lastHistorySessionId = 0;
 	FullMsgId _lastHistoryItemId;
@@ -277,6 +289,7 @@ public:
 		int forwardedCount = 0;
 		PeerData *reactionFrom = nullptr;
 		Data::ReactionId reactionId;
+		int collapsedCount = 0;
 	};
 
 	explicit Manager(not_null<System*> system) : _system(system) {
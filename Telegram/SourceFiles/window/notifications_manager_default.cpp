@@ -95,6 +95,7 @@ Manager::QueuedNotification::QueuedNotification(NotificationFields &&fields)
 	: QString())
 , item((fields.forwardedCount < 2) ? fields.item.get() : nullptr)
 , forwardedCount(fields.forwardedCount)
+, collapsedCount(fields.collapsedCount)
 , fromScheduled(reaction.empty() && (fields.item->out() || peer->isSelf())
 	&& fields.item->isFromScheduled()) {
 }
@@ -247,6 +248,7 @@ void Manager::showNextFromQueue() {
 			queued.item,
 			queued.reaction,
 			queued.forwardedCount,
+			queued.collapsedCount,
 			queued.fromScheduled,
 			startPosition,
 			startShift,
@@ -619,6 +621,7 @@ Notification::Notification(
 	HistoryItem *item,
 	const Data::ReactionId &reaction,
 	int forwardedCount,
+	int collapsedCount,
 	bool fromScheduled,
 	QPoint startPosition,
 	int shift,
@@ -634,6 +637,7 @@ Notification::Notification(
 , _reaction(reaction)
 , _item(item)
 , _forwardedCount(forwardedCount)
+, _collapsedCount(collapsedCount)
 , _fromScheduled(fromScheduled)
 , _close(this, st::notifyClose)
 , _reply(this, tr::lng_notification_reply(), st::defaultBoxButton) {
@@ -927,7 +931,12 @@ void Notification::updateNotifyDisplay() {
 					.hideSender = reminder,
 					.generateImages = false,
 					.spoilerLoginCode = options.spoilerLoginCode,
-				}).text
+				}).text.append(_collapsedCount > 0
+					? ('\n' + tr::lng_notification_more_messages(
+						tr::now,
+						lt_count,
+						_collapsedCount))
+					: QString())
 				: ((!_author.isEmpty()
 						? Ui::Text::Colorized(_author)
 						: TextWithEntities()
@@ -940,7 +949,9 @@ void Notification::updateNotifyDisplay() {
 			const auto options = TextParseOptions{
 				(TextParseColorized
 					| TextParseMarkdown
-					| (_forwardedCount > 1 ? TextParseMultiline : 0)),
+					| ((_forwardedCount > 1 || _collapsedCount > 0)
+						? TextParseMultiline
+						: 0)),
 				0,
 				0,
 				Qt::LayoutDirectionAuto,
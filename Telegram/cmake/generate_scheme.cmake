@@ -16,6 +16,7 @@ function(generate_scheme target_name script scheme_files)
         ${gen_dst}/scheme.h
         ${gen_dst}/scheme-dump_to_text.cpp
         ${gen_dst}/scheme-dump_to_text.h
+        ${gen_dst}/scheme-dispatch.h
     )
 
     add_custom_command(
@@ -31,6 +32,7 @@ function(generate_scheme target_name script scheme_files)
     COMMENT "Generating scheme (${target_name})"
     DEPENDS
         ${script}
+        ${src_loc}/codegen/scheme/scheme_dispatch.py
         ${submodules_loc}/lib_tl/tl/generate_tl.py
         ${scheme_files}
     )
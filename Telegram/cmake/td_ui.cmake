@@ -219,6 +219,8 @@ PRIVATE
 
     statistics/chart_lines_filter_controller.cpp
     statistics/chart_lines_filter_controller.h
+    statistics/chart_points_pyramid.cpp
+    statistics/chart_points_pyramid.h
     statistics/chart_rulers_data.cpp
     statistics/chart_rulers_data.h
     statistics/chart_widget.cpp